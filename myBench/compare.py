@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+"""Compare a myBench json report against a stored baseline.
+
+usage : compare.py <baseline.json> <contender.json> [--threshold 0.10]
+
+Prints the relative change of cpu_time (and of the hardware counters when both
+reports have them) for every benchmark present in both files, and exits with 1
+if a benchmark got slower than the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+COUNTERS = ("cycles", "instructions", "branch-misses")
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    return {b["name"]: b for b in report["benchmarks"] if b.get("run_type", "iteration") == "iteration"}
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.10, help="relative slowdown considered a regression")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+
+    regressions = 0
+    print("%-60s %12s %12s %8s" % ("benchmark", "baseline", "contender", "change"))
+    for name, new in contender.items():
+        old = baseline.get(name)
+        if old is None:
+            continue
+        change = (new["cpu_time"] - old["cpu_time"]) / old["cpu_time"]
+        line = "%-60s %12.2f %12.2f %+7.1f%%" % (name, old["cpu_time"], new["cpu_time"], 100 * change)
+        for counter in COUNTERS:
+            if counter in old and counter in new and old[counter]:
+                line += "  %s %+.1f%%" % (counter, 100 * (new[counter] - old[counter]) / old[counter])
+        if change > args.threshold:
+            line += "  <-- regression"
+            regressions += 1
+        print(line)
+
+    missing = sorted(set(baseline) - set(contender))
+    if missing:
+        print("\nnot in contender : " + ", ".join(missing))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
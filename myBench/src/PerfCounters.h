@@ -0,0 +1,114 @@
+#ifndef PerfCounters_H
+#define PerfCounters_H
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// \class PerfCounters
+/// \brief read hardware counters with perf_event around a benchmark loop, silently does nothing if they are not available
+/// (not Linux, perf_event_paranoid too high, virtual machine without PMU...)
+class PerfCounters
+{
+    public:
+        /// \brief open and start the counters
+        /// \param state : the benchmark state which will receive the counters (averaged by iteration)
+        explicit PerfCounters(benchmark::State& state) : m_state(state)
+        {
+#if defined(__linux__)
+            for (int i = 0; i < nb_counters; ++i)
+            {
+                m_fd[i] = open_counter(events[i].config, i == 0 ? -1 : m_fd[0]);
+                if (m_fd[i] == -1)
+                {
+                    close_all();
+                    return;
+                }
+            }
+            ioctl(m_fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(m_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        /// \brief stop the counters and report them in the benchmark state
+        ~PerfCounters()
+        {
+#if defined(__linux__)
+            if (m_fd[0] == -1)
+            {
+                return;
+            }
+            ioctl(m_fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+            // PERF_FORMAT_GROUP layout : nb, then one value per counter
+            uint64_t values[1 + nb_counters] = {};
+            if (read(m_fd[0], values, sizeof(values)) == sizeof(values))
+            {
+                for (int i = 0; i < nb_counters; ++i)
+                {
+                    m_state.counters[events[i].name] = benchmark::Counter(double(values[1 + i]), benchmark::Counter::kAvgIterations);
+                }
+            }
+            close_all();
+#endif
+        }
+
+        /// \brief return true if the hardware counters could be opened
+        bool available() const { return m_fd[0] != -1; }
+
+    private:
+        static constexpr int nb_counters = 3;
+
+#if defined(__linux__)
+        struct Event
+        {
+            const char* name;
+            uint64_t config;
+        };
+
+        static constexpr Event events[nb_counters] = {
+            {"cycles", PERF_COUNT_HW_CPU_CYCLES},
+            {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+            {"branch-misses", PERF_COUNT_HW_BRANCH_MISSES}
+        };
+
+        static int open_counter(uint64_t config, int group_fd)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.disabled = (group_fd == -1);
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            return int(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+        }
+
+        void close_all()
+        {
+            for (int i = 0; i < nb_counters; ++i)
+            {
+                if (m_fd[i] != -1)
+                {
+                    close(m_fd[i]);
+                    m_fd[i] = -1;
+                }
+            }
+        }
+#endif
+
+        benchmark::State& m_state; /**< state receiving the counters */
+        int m_fd[nb_counters] = {-1, -1, -1}; /**< perf_event file descriptors, the first one is the group leader */
+};
+
+#endif
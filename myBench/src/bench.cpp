@@ -0,0 +1,1027 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "Rational.h"
+#include "MultiModular.h"
+#include "Geometry.h"
+#include "LinearProgram.h"
+#include "Farey.h"
+#include "Transcendental.h"
+#include "Polynomial.h"
+#include "BoundedRational.h"
+#include "PerfCounters.h"
+
+// Every benchmark cycles through a fixed pool of pre-generated operands (fixed seed) so the results are reproducible
+// and comparable against a stored baseline, and the compiler can't fold the operations.
+// Values stay small enough so that Rational<int> never overflows.
+
+constexpr size_t pool_size = 1024;
+
+/// \brief return a pool of Rational with numerator in [-100, 100] and denominator in [1, 100]
+std::vector<Rational<int>> make_rational_pool()
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> numerator(-100, 100);
+    std::uniform_int_distribution<int> denominator(1, 100);
+    std::vector<Rational<int>> pool;
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        pool.emplace_back(numerator(generator), denominator(generator));
+    }
+    return pool;
+}
+
+/// \brief return a pool of operands of type U for the mixed operators
+template<typename U>
+std::vector<U> make_operand_pool()
+{
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> hundredths(-1000, 1000);
+    std::vector<U> pool;
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        if constexpr (std::is_same_v<U, Rational<int>>)
+        {
+            pool.emplace_back(hundredths(generator), 100);
+        }
+        else if constexpr (std::is_integral_v<U>)
+        {
+            pool.push_back(U(hundredths(generator) / 100));
+        }
+        else
+        {
+            pool.push_back(U(hundredths(generator)) / 100);
+        }
+    }
+    return pool;
+}
+
+/// \brief distributions of real values given to convert_real_to_ratio
+enum Distribution
+{
+    unit_interval,  /**< uniform in [0, 1) */
+    large,          /**< uniform in [1, 10000) */
+    near_integer,   /**< integer + noise under default_error_value */
+    small,          /**< uniform in [1e-3, 1e-2) */
+    negative,       /**< uniform in (-100, 0] */
+    hundredths      /**< exact decimal values with 2 digits, the common case */
+};
+
+/// \brief return a pool of real values following a distribution
+template<typename U>
+std::vector<U> make_real_pool(int distribution)
+{
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<U> pool;
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        double u = uniform(generator);
+        switch (distribution)
+        {
+            case unit_interval: pool.push_back(U(u)); break;
+            case large: pool.push_back(U(1 + u * 9999)); break;
+            case near_integer: pool.push_back(U(std::floor(u * 100) + u * 1e-5)); break;
+            case small: pool.push_back(U(1e-3 + u * 9e-3)); break;
+            case negative: pool.push_back(U(-u * 100)); break;
+            default: pool.push_back(U(std::floor(u * 10000) / 100)); break;
+        }
+    }
+    return pool;
+}
+
+//Construction
+
+static void BM_DefaultConstructor(benchmark::State& state)
+{
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        Rational<int> ratio;
+        benchmark::DoNotOptimize(ratio);
+    }
+}
+BENCHMARK(BM_DefaultConstructor);
+
+/// \brief value constructor, range(0) selects the input : 0 already irreducible, 1 reducible, 2 negative denominator
+static void BM_ValueConstructor(benchmark::State& state)
+{
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int> distribution(1, 1000);
+    std::vector<std::pair<int, int>> pool;
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        int a = distribution(generator);
+        int b = distribution(generator);
+        int g = std::gcd(a, b);
+        switch (state.range(0))
+        {
+            case 0: pool.emplace_back(a / g, b / g); break;
+            case 1: pool.emplace_back(a * 12, b * 12); break;
+            default: pool.emplace_back(a, -b); break;
+        }
+    }
+
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto& p = pool[i++ % pool_size];
+        Rational<int> ratio(p.first, p.second);
+        benchmark::DoNotOptimize(ratio);
+    }
+}
+BENCHMARK(BM_ValueConstructor)->Arg(0)->Arg(1)->Arg(2);
+
+static void BM_CopyConstructor(benchmark::State& state)
+{
+    std::vector<Rational<int>> pool = make_rational_pool();
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        Rational<int> ratio(pool[i++ % pool_size]);
+        benchmark::DoNotOptimize(ratio);
+    }
+}
+BENCHMARK(BM_CopyConstructor);
+
+//Conversion
+
+/// \brief convert_real_to_ratio, range(0) is the Distribution and range(1) the number of iterations
+template<typename U>
+static void BM_ConvertRealToRatio(benchmark::State& state)
+{
+    std::vector<U> pool = make_real_pool<U>(int(state.range(0)));
+    const uint nb_iter = uint(state.range(1));
+    Rational<int> ratio;
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ratio.convert_real_to_ratio<U>(pool[i++ % pool_size], nb_iter));
+    }
+}
+BENCHMARK_TEMPLATE(BM_ConvertRealToRatio, float)
+    ->ArgsProduct({{unit_interval, large, near_integer, small, negative, hundredths}, {default_nb_iter}});
+BENCHMARK_TEMPLATE(BM_ConvertRealToRatio, double)
+    ->ArgsProduct({{unit_interval, large, near_integer, small, negative, hundredths}, {default_nb_iter}});
+BENCHMARK_TEMPLATE(BM_ConvertRealToRatio, double)->ArgsProduct({{unit_interval}, {1, 2, 5, 20}});
+
+/// \brief real value constructor, goes through convert_real_to_ratio and the affectation operator
+template<typename U>
+static void BM_RealValueConstructor(benchmark::State& state)
+{
+    std::vector<U> pool = make_real_pool<U>(hundredths);
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        Rational<int> ratio(pool[i++ % pool_size]);
+        benchmark::DoNotOptimize(ratio);
+    }
+}
+BENCHMARK_TEMPLATE(BM_RealValueConstructor, int);
+BENCHMARK_TEMPLATE(BM_RealValueConstructor, float);
+BENCHMARK_TEMPLATE(BM_RealValueConstructor, double);
+
+//Operators
+
+struct Plus { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a + b; } };
+struct Minus { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a - b; } };
+struct Multiply { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a * b; } };
+struct Divide { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a / b; } };
+struct PlusEqual { template<typename U> auto operator()(Rational<int> a, const U& b) const { a += b; return a; } };
+struct MinusEqual { template<typename U> auto operator()(Rational<int> a, const U& b) const { a -= b; return a; } };
+struct MultiplyEqual { template<typename U> auto operator()(Rational<int> a, const U& b) const { a *= b; return a; } };
+struct DivideEqual { template<typename U> auto operator()(Rational<int> a, const U& b) const { a /= b; return a; } };
+struct IsEqual { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a == b; } };
+struct IsDifferent { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a != b; } };
+struct IsSuperior { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a > b; } };
+struct IsSuperiorOrEqual { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a >= b; } };
+struct IsInferior { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a < b; } };
+struct IsInferiorOrEqual { template<typename U> auto operator()(const Rational<int>& a, const U& b) const { return a <= b; } };
+
+/// \brief binary operator Op between a Rational<int> and an operand of type U
+template<typename Op, typename U>
+static void BM_Operator(benchmark::State& state)
+{
+    std::vector<Rational<int>> pool = make_rational_pool();
+    std::vector<U> operands = make_operand_pool<U>();
+    if constexpr (std::is_same_v<Op, Divide> || std::is_same_v<Op, DivideEqual>)
+    {
+        for (U& operand : operands)
+        {
+            if (operand == 0)
+            {
+                operand = U(1);
+            }
+        }
+    }
+
+    Op op;
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(op(pool[i % pool_size], operands[i % pool_size]));
+        ++i;
+    }
+}
+
+#define RATIONAL_BENCHMARK_OPERATOR(Op) \
+    BENCHMARK_TEMPLATE(BM_Operator, Op, int); \
+    BENCHMARK_TEMPLATE(BM_Operator, Op, float); \
+    BENCHMARK_TEMPLATE(BM_Operator, Op, double); \
+    BENCHMARK_TEMPLATE(BM_Operator, Op, Rational<int>)
+
+RATIONAL_BENCHMARK_OPERATOR(Plus);
+RATIONAL_BENCHMARK_OPERATOR(Minus);
+RATIONAL_BENCHMARK_OPERATOR(Multiply);
+RATIONAL_BENCHMARK_OPERATOR(Divide);
+RATIONAL_BENCHMARK_OPERATOR(PlusEqual);
+RATIONAL_BENCHMARK_OPERATOR(MinusEqual);
+RATIONAL_BENCHMARK_OPERATOR(MultiplyEqual);
+RATIONAL_BENCHMARK_OPERATOR(DivideEqual);
+RATIONAL_BENCHMARK_OPERATOR(IsEqual);
+RATIONAL_BENCHMARK_OPERATOR(IsDifferent);
+RATIONAL_BENCHMARK_OPERATOR(IsSuperior);
+RATIONAL_BENCHMARK_OPERATOR(IsSuperiorOrEqual);
+RATIONAL_BENCHMARK_OPERATOR(IsInferior);
+RATIONAL_BENCHMARK_OPERATOR(IsInferiorOrEqual);
+
+static void BM_UnaryMinus(benchmark::State& state)
+{
+    std::vector<Rational<int>> pool = make_rational_pool();
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(-pool[i++ % pool_size]);
+    }
+}
+BENCHMARK(BM_UnaryMinus);
+
+//Functions
+
+/// \brief recursive pow, range(0) is the power
+static void BM_Pow(benchmark::State& state)
+{
+    // 5/4 to the 13th (1220703125/67108864) is the largest power of the pool that still fits in an int
+    std::vector<Rational<int>> pool = {Rational<int>(3, 2), Rational<int>(-2, 3), Rational<int>(1, 2), Rational<int>(5, 4)};
+    const uint n = uint(state.range(0));
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pool[i++ % pool.size()].pow(n));
+    }
+}
+BENCHMARK(BM_Pow)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(13);
+
+static void BM_Reverse(benchmark::State& state)
+{
+    std::vector<Rational<int>> pool = make_rational_pool();
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(pool[i++ % pool_size].reverse());
+    }
+}
+BENCHMARK(BM_Reverse);
+
+static void BM_Min(benchmark::State& state)
+{
+    std::vector<Rational<int>> pool = make_rational_pool();
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const Rational<int>& a = pool[i % pool_size];
+        benchmark::DoNotOptimize(a.min(a, pool[(i + 1) % pool_size]));
+        ++i;
+    }
+}
+BENCHMARK(BM_Min);
+
+static void BM_MinVariadic(benchmark::State& state)
+{
+    std::vector<Rational<int>> pool = make_rational_pool();
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const Rational<int>& a = pool[i % pool_size];
+        benchmark::DoNotOptimize(a.min(a, pool[(i + 1) % pool_size], pool[(i + 2) % pool_size], pool[(i + 3) % pool_size]));
+        ++i;
+    }
+}
+BENCHMARK(BM_MinVariadic);
+
+static void BM_Max(benchmark::State& state)
+{
+    std::vector<Rational<int>> pool = make_rational_pool();
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const Rational<int>& a = pool[i % pool_size];
+        benchmark::DoNotOptimize(a.max(a, pool[(i + 1) % pool_size]));
+        ++i;
+    }
+}
+BENCHMARK(BM_Max);
+
+static void BM_MaxVariadic(benchmark::State& state)
+{
+    std::vector<Rational<int>> pool = make_rational_pool();
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const Rational<int>& a = pool[i % pool_size];
+        benchmark::DoNotOptimize(a.max(a, pool[(i + 1) % pool_size], pool[(i + 2) % pool_size], pool[(i + 3) % pool_size]));
+        ++i;
+    }
+}
+BENCHMARK(BM_MaxVariadic);
+
+//Exact linear algebra
+
+/// \brief Hilbert matrix of size n and right hand side b = H x with x = (1, -1/2, 1/3, ...)
+static void make_hilbert_system(size_t n, std::vector<std::vector<Rational<long long>>>& A, std::vector<Rational<long long>>& b)
+{
+    A.assign(n, std::vector<Rational<long long>>(n));
+    b.assign(n, Rational<long long>());
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            A[i][j] = Rational<long long>(1, (long long)(i + j + 1));
+            b[i] += A[i][j] * Rational<long long>(j % 2 == 0 ? 1 : -1, (long long)(j + 1));
+        }
+    }
+}
+
+/// \brief Gauss-Jordan elimination directly in Rational<long long>, the reference for the multi-modular solver
+static std::vector<Rational<long long>> rational_solve(std::vector<std::vector<Rational<long long>>> A, std::vector<Rational<long long>> b)
+{
+    const size_t n = A.size();
+    for (size_t col = 0; col < n; ++col)
+    {
+        size_t pivot = col;
+        while (A[pivot][col] == 0)
+        {
+            ++pivot;
+        }
+        std::swap(A[pivot], A[col]);
+        std::swap(b[pivot], b[col]);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (i != col && A[i][col] != 0)
+            {
+                Rational<long long> factor = A[i][col] / A[col][col];
+                for (size_t j = col; j < n; ++j)
+                {
+                    A[i][j] -= factor * A[col][j];
+                }
+                b[i] -= factor * b[col];
+            }
+        }
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        b[i] /= A[i][i];
+    }
+    return b;
+}
+
+/// \brief range(0) is the size of the Hilbert system
+static void BM_RationalSolve(benchmark::State& state)
+{
+    std::vector<std::vector<Rational<long long>>> A;
+    std::vector<Rational<long long>> b;
+    make_hilbert_system(size_t(state.range(0)), A, b);
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(rational_solve(A, b));
+    }
+}
+BENCHMARK(BM_RationalSolve)->Arg(4)->Arg(6);
+
+/// \brief range(0) is the size of the Hilbert system
+static void BM_ModularSolve(benchmark::State& state)
+{
+    std::vector<std::vector<Rational<long long>>> A;
+    std::vector<Rational<long long>> b;
+    make_hilbert_system(size_t(state.range(0)), A, b);
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(modular_solve(A, b));
+    }
+}
+BENCHMARK(BM_ModularSolve)->Arg(4)->Arg(6)->Arg(8)->UseRealTime();
+
+//Geometry
+
+/// \brief random small coordinates k/100
+static Rational<int> random_coordinate(std::mt19937& generator)
+{
+    std::uniform_int_distribution<int> hundredths(-1000, 1000);
+    return Rational<int>(hundredths(generator), 100);
+}
+
+/// \brief triples of points of the plane, exactly collinear if degenerate
+static std::vector<std::array<Point2<int>, 3>> make_orient2d_pool(bool degenerate)
+{
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> tenths(-20, 20);
+    std::vector<std::array<Point2<int>, 3>> pool;
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        Point2<int> a(random_coordinate(generator), random_coordinate(generator));
+        Point2<int> b(random_coordinate(generator), random_coordinate(generator));
+        Point2<int> c = (degenerate ? a + (b - a) * Rational<int>(tenths(generator), 10) : Point2<int>(random_coordinate(generator), random_coordinate(generator)));
+        pool.push_back({a, b, c});
+    }
+    return pool;
+}
+
+/// \brief quadruples of points of the space, exactly coplanar if degenerate
+static std::vector<std::array<Point3<int>, 4>> make_orient3d_pool(bool degenerate)
+{
+    std::mt19937 generator(13);
+    std::uniform_int_distribution<int> tenths(-20, 20);
+    auto random_point = [&generator]() { return Point3<int>(random_coordinate(generator), random_coordinate(generator), random_coordinate(generator)); };
+    std::vector<std::array<Point3<int>, 4>> pool;
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        Point3<int> a = random_point(), b = random_point(), c = random_point();
+        Point3<int> d = (degenerate ? a + (b - a) * Rational<int>(tenths(generator), 10) + (c - a) * Rational<int>(tenths(generator), 10) : random_point());
+        pool.push_back({a, b, c, d});
+    }
+    return pool;
+}
+
+/// \brief quadruples of points of the plane, exactly cocircular (on the unit circle) if degenerate
+static std::vector<std::array<Point2<int>, 4>> make_incircle_pool(bool degenerate)
+{
+    std::mt19937 generator(17);
+    std::uniform_int_distribution<int> parameter(-50, 50);
+    auto on_circle = [&generator, &parameter]()
+    {
+        int p = parameter(generator), q = 51;
+        return Point2<int>(Rational<int>(q * q - p * p, q * q + p * p), Rational<int>(2 * p * q, q * q + p * p));
+    };
+    std::vector<std::array<Point2<int>, 4>> pool;
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        if (degenerate)
+        {
+            pool.push_back({on_circle(), on_circle(), on_circle(), on_circle()});
+        }
+        else
+        {
+            pool.push_back({Point2<int>(random_coordinate(generator), random_coordinate(generator)), Point2<int>(random_coordinate(generator), random_coordinate(generator)),
+                            Point2<int>(random_coordinate(generator), random_coordinate(generator)), Point2<int>(random_coordinate(generator), random_coordinate(generator))});
+        }
+    }
+    return pool;
+}
+
+/// \brief range(0) : 0 random inputs, 1 degenerate inputs ; range(1) : 0 filtered, 1 exact only
+static void BM_Orient2d(benchmark::State& state)
+{
+    std::vector<std::array<Point2<int>, 3>> pool = make_orient2d_pool(state.range(0) == 1);
+    const bool exact = (state.range(1) == 1);
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto& p = pool[i++ % pool_size];
+        benchmark::DoNotOptimize(exact ? orient2d_exact(p[0], p[1], p[2]) : orient2d(p[0], p[1], p[2]));
+    }
+}
+BENCHMARK(BM_Orient2d)->ArgsProduct({{0, 1}, {0, 1}});
+
+/// \brief range(0) : 0 random inputs, 1 degenerate inputs ; range(1) : 0 filtered, 1 exact only
+static void BM_Orient3d(benchmark::State& state)
+{
+    std::vector<std::array<Point3<int>, 4>> pool = make_orient3d_pool(state.range(0) == 1);
+    const bool exact = (state.range(1) == 1);
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto& p = pool[i++ % pool_size];
+        benchmark::DoNotOptimize(exact ? orient3d_exact(p[0], p[1], p[2], p[3]) : orient3d(p[0], p[1], p[2], p[3]));
+    }
+}
+BENCHMARK(BM_Orient3d)->ArgsProduct({{0, 1}, {0, 1}});
+
+/// \brief range(0) : 0 random inputs, 1 degenerate inputs ; range(1) : 0 filtered, 1 exact only
+static void BM_Incircle(benchmark::State& state)
+{
+    std::vector<std::array<Point2<int>, 4>> pool = make_incircle_pool(state.range(0) == 1);
+    const bool exact = (state.range(1) == 1);
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto& p = pool[i++ % pool_size];
+        benchmark::DoNotOptimize(exact ? incircle_exact(p[0], p[1], p[2], p[3]) : incircle(p[0], p[1], p[2], p[3]));
+    }
+}
+BENCHMARK(BM_Incircle)->ArgsProduct({{0, 1}, {0, 1}});
+
+/// \brief range(0) : 0 random segments, 1 segments through a common point
+static void BM_IntersectionPoint(benchmark::State& state)
+{
+    std::vector<std::array<Point2<int>, 3>> pool = make_orient2d_pool(state.range(0) == 1);
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const auto& p = pool[i % pool_size];
+        const auto& q = pool[(i + 1) % pool_size];
+        benchmark::DoNotOptimize(intersection_point(p[0], p[2], q[0], q[1]));
+        ++i;
+    }
+}
+BENCHMARK(BM_IntersectionPoint)->Arg(0)->Arg(1);
+
+//Linear programming
+
+/// \brief Beale's example, cycles with Dantzig's rule and naive tie breaking
+static LinearProgram<long long> make_beale()
+{
+    using R = Rational<long long>;
+    LinearProgram<long long> program(4);
+    program.set_objective({R(3, 4), R(-150), R(1, 50), R(-6)});
+    program.add_constraint({R(1, 4), R(-60), R(-1, 25), R(9)}, LinearProgram<long long>::less_equal, R(0));
+    program.add_constraint({R(1, 2), R(-90), R(-1, 50), R(3)}, LinearProgram<long long>::less_equal, R(0));
+    program.add_constraint({R(0), R(0), R(1), R(0)}, LinearProgram<long long>::less_equal, R(1));
+    return program;
+}
+
+/// \brief Klee-Minty cube of dimension n, 2^n - 1 pivots with Dantzig's rule
+static LinearProgram<long long> make_klee_minty(size_t n)
+{
+    using R = Rational<long long>;
+    LinearProgram<long long> program(n);
+    std::vector<R> objective;
+    long long power_of_5 = 1;
+    for (size_t i = 0; i < n; ++i)
+    {
+        objective.push_back(R(1ll << (n - 1 - i)));
+        LinearProgram<long long>::SparseRow row;
+        for (size_t j = 0; j < i; ++j)
+        {
+            row.emplace_back(j, R(1ll << (i - j + 1)));
+        }
+        row.emplace_back(i, R(1));
+        power_of_5 *= 5;
+        program.add_constraint(row, LinearProgram<long long>::less_equal, R(power_of_5));
+    }
+    program.set_objective(objective);
+    return program;
+}
+
+/// \brief n x n assignment problem, every vertex is highly degenerate and one equality is redundant
+static LinearProgram<long long> make_assignment(size_t n)
+{
+    using R = Rational<long long>;
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<int> costs(1, 20);
+    LinearProgram<long long> program(n * n);
+    std::vector<R> objective;
+    for (size_t k = 0; k < n * n; ++k)
+    {
+        objective.push_back(R(-costs(generator)));
+    }
+    program.set_objective(objective);
+    for (size_t i = 0; i < n; ++i)
+    {
+        LinearProgram<long long>::SparseRow row, column;
+        for (size_t j = 0; j < n; ++j)
+        {
+            row.emplace_back(i * n + j, R(1));
+            column.emplace_back(j * n + i, R(1));
+        }
+        program.add_constraint(row, LinearProgram<long long>::equal, R(1));
+        program.add_constraint(column, LinearProgram<long long>::equal, R(1));
+    }
+    return program;
+}
+
+/// \brief range(0) is 1 for float guided pivoting, 0 for exact pivoting only
+static void BM_LinearProgramBeale(benchmark::State& state)
+{
+    LinearProgram<long long> program = make_beale();
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(program.solve(state.range(0) != 0));
+    }
+}
+BENCHMARK(BM_LinearProgramBeale)->Arg(0)->Arg(1);
+
+/// \brief range(0) is the dimension, range(1) is 1 for float guided pivoting
+static void BM_LinearProgramKleeMinty(benchmark::State& state)
+{
+    LinearProgram<long long> program = make_klee_minty(size_t(state.range(0)));
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(program.solve(state.range(1) != 0));
+    }
+}
+BENCHMARK(BM_LinearProgramKleeMinty)->ArgsProduct({{4, 6, 8}, {0, 1}});
+
+/// \brief range(0) is the size of the assignment, range(1) is 1 for float guided pivoting
+static void BM_LinearProgramAssignment(benchmark::State& state)
+{
+    LinearProgram<long long> program = make_assignment(size_t(state.range(0)));
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(program.solve(state.range(1) != 0));
+    }
+}
+BENCHMARK(BM_LinearProgramAssignment)->ArgsProduct({{4, 6}, {0, 1}});
+
+//Farey sequences
+
+/// \brief range(0) is N, every term built then sorted with Rational comparisons
+static void BM_FareySorted(benchmark::State& state)
+{
+    const long long n = state.range(0);
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        std::vector<Rational<long long>> terms;
+        for (long long q = 1; q <= n; ++q)
+        {
+            for (long long p = 0; p <= q; ++p)
+            {
+                if (std::gcd(p, q) == 1)
+                {
+                    terms.push_back(Rational<long long>(p, q));
+                }
+            }
+        }
+        std::sort(terms.begin(), terms.end(), [](const Rational<long long>& a, const Rational<long long>& b) { return a < b; });
+        benchmark::DoNotOptimize(terms.data());
+    }
+}
+BENCHMARK(BM_FareySorted)->Arg(100)->Arg(1000);
+
+/// \brief range(0) is N, terms generated by the next-term recurrence
+static void BM_FareyRecurrence(benchmark::State& state)
+{
+    FareySequence<long long> farey(state.range(0));
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (const Rational<long long>& term : farey)
+        {
+            sum += term.get_denominator();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_FareyRecurrence)->Arg(100)->Arg(1000);
+
+/// \brief range(0) is N, range(1) the number of chunks, each summed on its own thread
+static void BM_FareyParallel(benchmark::State& state)
+{
+    FareySequence<long long> farey(state.range(0));
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        std::vector<std::future<long long>> sums;
+        for (const auto& range : farey.chunks(size_t(state.range(1))))
+        {
+            sums.push_back(std::async(std::launch::async, [range]()
+            {
+                long long sum = 0;
+                for (const Rational<long long>& term : range)
+                {
+                    sum += term.get_denominator();
+                }
+                return sum;
+            }));
+        }
+        long long sum = 0;
+        for (auto& partial : sums)
+        {
+            sum += partial.get();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_FareyParallel)->ArgsProduct({{10000}, {1, 4}})->UseRealTime();
+
+//Transcendental functions
+
+/// \brief return the Rational<long long> arguments of the transcendental benchmarks, in [-4, 4]
+std::vector<Rational<long long>> make_transcendental_pool()
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<long long> numerator(-4000, 4000);
+    std::uniform_int_distribution<long long> denominator(1, 1000);
+    std::vector<Rational<long long>> pool;
+    for (size_t i = 0; i < pool_size; ++i)
+    {
+        long long den = denominator(generator);
+        pool.push_back(Rational<long long>(numerator(generator) * den / 1000, den));
+    }
+    return pool;
+}
+
+/// \brief 10^-range(0) as a Rational<long long>
+Rational<long long> precision_of(const benchmark::State& state)
+{
+    long long den = 1;
+    for (long long i = 0; i < state.range(0); ++i)
+    {
+        den *= 10;
+    }
+    return Rational<long long>(1, den);
+}
+
+/// \brief report the largest error against long double and the largest denominator (bits) of the results
+void report_accuracy(benchmark::State& state, const std::vector<Rational<long long>>& arguments, const std::vector<Rational<long long>>& results, long double (*reference)(long double))
+{
+    long double max_error = 0;
+    long long max_denominator = 1;
+    for (size_t i = 0; i < arguments.size(); ++i)
+    {
+        long double x = (long double)arguments[i].get_numerator() / arguments[i].get_denominator();
+        long double y = (long double)results[i].get_numerator() / results[i].get_denominator();
+        max_error = std::max(max_error, std::fabs(y - reference(x)));
+        max_denominator = std::max(max_denominator, results[i].get_denominator());
+    }
+    state.counters["max_error"] = double(max_error);
+    state.counters["denominator_bits"] = std::log2(double(max_denominator));
+}
+
+long double reference_sin(long double x) { return std::sin(x); }
+long double reference_exp(long double x) { return std::exp(x); }
+
+/// \brief range(0) is the number of decimal digits asked, one argument at a time
+static void BM_TranscendentalSin(benchmark::State& state)
+{
+    const std::vector<Rational<long long>> pool = make_transcendental_pool();
+    Transcendental<long long> kernel(precision_of(state));
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kernel.sin(pool[i++ % pool_size]));
+    }
+    report_accuracy(state, pool, kernel.sin(pool), reference_sin);
+}
+BENCHMARK(BM_TranscendentalSin)->Arg(3)->Arg(6)->Arg(9)->Arg(12);
+
+/// \brief range(0) is the number of decimal digits asked, the whole pool through the batch interface
+static void BM_TranscendentalSinBatch(benchmark::State& state)
+{
+    const std::vector<Rational<long long>> pool = make_transcendental_pool();
+    Transcendental<long long> kernel(precision_of(state));
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kernel.sin(pool).data());
+    }
+    state.SetItemsProcessed(state.iterations() * pool_size);
+}
+BENCHMARK(BM_TranscendentalSinBatch)->Arg(3)->Arg(12);
+
+/// \brief range(0) is the number of decimal digits asked, arguments in [-4, 4]
+static void BM_TranscendentalExp(benchmark::State& state)
+{
+    const std::vector<Rational<long long>> pool = make_transcendental_pool();
+    Transcendental<long long> kernel(precision_of(state));
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(kernel.exp(pool[i++ % pool_size]));
+    }
+    report_accuracy(state, pool, kernel.exp(pool), reference_exp);
+}
+BENCHMARK(BM_TranscendentalExp)->Arg(3)->Arg(6)->Arg(9)->Arg(12);
+
+/// \brief baseline : the float sin() of Rational converted back to a Rational
+static void BM_FloatSinBaseline(benchmark::State& state)
+{
+    const std::vector<Rational<long long>> pool = make_transcendental_pool();
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Rational<long long>().convert_real_to_ratio(pool[i++ % pool_size].sin(), default_nb_iter));
+    }
+    std::vector<Rational<long long>> results;
+    for (const Rational<long long>& x : pool)
+    {
+        results.push_back(Rational<long long>().convert_real_to_ratio(x.sin(), default_nb_iter));
+    }
+    report_accuracy(state, pool, results, reference_sin);
+}
+BENCHMARK(BM_FloatSinBaseline);
+
+//Polynomials
+
+/// \brief return a polynomial with `size` coefficients taken from the pool, as Rational<long long>
+RationalPolynomial<long long> make_polynomial(const std::vector<Rational<int>>& pool, const size_t size, const size_t offset)
+{
+    std::vector<Rational<long long>> coefficients;
+    for (size_t i = 0; i < size; ++i)
+    {
+        const Rational<int>& ratio = pool[(offset + i) % pool_size];
+        coefficients.push_back(Rational<long long>(ratio.get_numerator() % 10, ratio.get_denominator() % 4 + 1));
+    }
+    return RationalPolynomial<long long>(coefficients);
+}
+
+/// \brief range(0) is the number of coefficients, range(1) 0 for the schoolbook product, 1 for Karatsuba (down to 8 coefficients)
+static void BM_PolynomialMultiply(benchmark::State& state)
+{
+    const std::vector<Rational<int>> pool = make_rational_pool();
+    const RationalPolynomial<long long> a = make_polynomial(pool, size_t(state.range(0)), 0);
+    const RationalPolynomial<long long> b = make_polynomial(pool, size_t(state.range(0)), 512);
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        if (state.range(1) == 0)
+        {
+            benchmark::DoNotOptimize(polynomial_detail::schoolbook(a.coefficients(), b.coefficients()).data());
+        }
+        else
+        {
+            benchmark::DoNotOptimize(polynomial_detail::karatsuba(a.coefficients(), b.coefficients(), 8).data());
+        }
+    }
+}
+BENCHMARK(BM_PolynomialMultiply)->ArgsProduct({{16, 32, 64, 128}, {0, 1}});
+
+/// \brief degree 8 at the whole pool, range(0) 0 for Rational Horner point by point, 1 for the batched integer Horner
+static void BM_PolynomialEvaluate(benchmark::State& state)
+{
+    const std::vector<Rational<int>> pool = make_rational_pool();
+    const RationalPolynomial<long long> p = make_polynomial(pool, 9, 100);
+    std::vector<Rational<long long>> points;
+    for (const Rational<int>& ratio : pool)
+    {
+        points.push_back(Rational<long long>(ratio.get_numerator(), ratio.get_denominator() % 8 + 1));
+    }
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+        {
+            for (const Rational<long long>& x : points)
+            {
+                benchmark::DoNotOptimize(p(x));
+            }
+        }
+        else
+        {
+            benchmark::DoNotOptimize(p.evaluate(points).data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * pool_size);
+}
+BENCHMARK(BM_PolynomialEvaluate)->Arg(0)->Arg(1);
+
+/// \brief real roots of (x - 1)...(x - range(0)) + 1/7, isolated then refined to 2^-range(1)
+static void BM_PolynomialRoots(benchmark::State& state)
+{
+    std::vector<Rational<long long>> roots;
+    for (long long k = 1; k <= state.range(0); ++k)
+    {
+        roots.push_back(Rational<long long>(k, 1));
+    }
+    const RationalPolynomial<long long> p = RationalPolynomial<long long>::from_roots(roots) + RationalPolynomial<long long>({Rational<long long>(1, 7)});
+    const Rational<long long> width(1, 1LL << state.range(1));
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(p.isolate_roots(width).data());
+    }
+}
+BENCHMARK(BM_PolynomialRoots)->ArgsProduct({{6, 10}, {10, 30}});
+
+//Bounded denominators
+
+/// \brief one rounded operation per pool pair on BoundedRational<long long, 1000000>, range(0) 0 for +, 1 for *, 2 for /
+static void BM_BoundedRationalOperation(benchmark::State& state)
+{
+    const std::vector<Rational<int>> pool = make_rational_pool();
+    std::vector<BoundedRational<long long, 1000000>> operands;
+    for (const Rational<int>& ratio : pool)
+    {
+        operands.emplace_back(ratio.get_numerator() == 0 ? 1 : ratio.get_numerator(), ratio.get_denominator());
+    }
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        const BoundedRational<long long, 1000000>& a = operands[i % pool_size];
+        const BoundedRational<long long, 1000000>& b = operands[(i + 1) % pool_size];
+        if (state.range(0) == 0)
+        {
+            benchmark::DoNotOptimize(a + b);
+        }
+        else if (state.range(0) == 1)
+        {
+            benchmark::DoNotOptimize(a * b);
+        }
+        else
+        {
+            benchmark::DoNotOptimize(a / b);
+        }
+        ++i;
+    }
+}
+BENCHMARK(BM_BoundedRationalOperation)->DenseRange(0, 2);
+
+/// \brief harmonic oscillator x'' = -x by 10000 symplectic Euler steps of 1/100, on float and on BoundedRational<long long, 1000000>
+/// \details range(0) 0 for float, 1 for BoundedRational, the error counter is the final distance to the long double run
+/// (the exact Rational denominators grow as 100^step and overflow after a few steps)
+static void BM_BoundedRationalOscillator(benchmark::State& state)
+{
+    constexpr int steps = 10000;
+    long double reference_x = 1, reference_v = 0;
+    for (int i = 0; i < steps; ++i)
+    {
+        reference_v -= reference_x / 100;
+        reference_x += reference_v / 100;
+    }
+    double x_value = 0;
+    PerfCounters counters(state);
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+        {
+            float x = 1, v = 0;
+            for (int i = 0; i < steps; ++i)
+            {
+                v -= x / 100;
+                x += v / 100;
+            }
+            x_value = x;
+        }
+        else
+        {
+            using B = BoundedRational<long long, 1000000>;
+            const B dt(1, 100);
+            B x(1), v(0);
+            for (int i = 0; i < steps; ++i)
+            {
+                v -= x * dt;
+                x += v * dt;
+            }
+            x_value = x.get_value();
+        }
+        benchmark::DoNotOptimize(x_value);
+    }
+    state.counters["error"] = std::fabs((long double)x_value - reference_x);
+    state.SetItemsProcessed(state.iterations() * steps);
+}
+BENCHMARK(BM_BoundedRationalOscillator)->Arg(0)->Arg(1);
+
+//Display
+
+static void BM_CoutOperator(benchmark::State& state)
+{
+    std::vector<Rational<int>> pool = make_rational_pool();
+    std::ostringstream stream;
+    PerfCounters counters(state);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        stream << pool[i++ % pool_size];
+        if (i % pool_size == 0)
+        {
+            stream.str("");
+        }
+    }
+    benchmark::DoNotOptimize(stream.str());
+}
+BENCHMARK(BM_CoutOperator);
+
+BENCHMARK_MAIN();
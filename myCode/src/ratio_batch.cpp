@@ -0,0 +1,710 @@
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Rational.h"
+#include "ContinuedFraction.h"
+
+/// \brief non-interactive batch tool : one number, fraction or expression per line in, one irreducible fraction per line out
+/// \details usage : ratio_batch [options] [files...], stdin is read when there is no file (or for "-")
+
+using Ratio = Rational<long long>;
+
+/// \brief output formats
+enum class Format
+{
+    text,   /**< "numerator/denominator", "error: message" */
+    binary  /**< 17 bytes records : status (0 value, 1 error, 2 blank line), numerator, denominator as native int64 */
+};
+
+/// \struct Settings
+/// \brief command line options
+struct Settings
+{
+    uint nb_iter = default_nb_iter; /**< iterations of convert_real_to_ratio for decimal literals */
+    float error_value = default_error_value; /**< floating parts under it are dropped by convert_real_to_ratio */
+    long long max_denominator = 0; /**< results are rounded to the best approximation with a bounded denominator, 0 for none */
+    Format format = Format::text; /**< output format */
+    size_t nb_threads = std::max(1u, std::thread::hardware_concurrency()); /**< workers parsing and evaluating */
+    size_t batch_lines = 8192; /**< lines per buffer */
+    bool throughput = false; /**< report lines/s and precision settings on stderr */
+    std::vector<std::string> files; /**< inputs, stdin if empty */
+};
+
+/// \class ExpressionParser
+/// \brief recursive descent parser evaluating + - * / ^ and parentheses over Rational
+/// \details integers are exact, decimal literals go through the continued fraction of convert_real_to_ratio with the requested
+/// number of iterations. Every operation, the conversion included, is computed on 128-bit integers and reduced : a result
+/// that doesn't fit in a long long is an error
+class ExpressionParser
+{
+    public:
+        ExpressionParser(const std::string& line, const uint nb_iter) : m_line(line), m_nb_iter(nb_iter) {}
+
+        /// \brief evaluate the whole line, throws std::invalid_argument on a syntax error, a division by 0 or an overflow
+        Ratio evaluate()
+        {
+            Ratio value = expression();
+            skip_spaces();
+            if (m_position != m_line.size())
+            {
+                fail("unexpected character");
+            }
+            return value;
+        }
+
+    private:
+        const std::string& m_line; /**< line to parse */
+        uint m_nb_iter; /**< iterations of convert_real_to_ratio */
+        size_t m_position = 0; /**< next character */
+
+        [[noreturn]] void fail(const std::string& message) const
+        {
+            throw std::invalid_argument(message + " at column " + std::to_string(m_position + 1));
+        }
+
+        //Checked arithmetic
+
+        /// \brief irreducible n/d with a positive denominator, fails if it doesn't fit in a long long
+        Ratio make(__int128 n, __int128 d) const
+        {
+            if (d < 0)
+            {
+                n = -n;
+                d = -d;
+            }
+            unsigned __int128 a = (unsigned __int128)(n < 0 ? -n : n), b = (unsigned __int128)(d);
+            while (b != 0)
+            {
+                unsigned __int128 r = a % b;
+                a = b;
+                b = r;
+            }
+            if (a > 1)
+            {
+                n /= (__int128)(a);
+                d /= (__int128)(a);
+            }
+            if (n < std::numeric_limits<long long>::min() || n > std::numeric_limits<long long>::max() || d > std::numeric_limits<long long>::max())
+            {
+                fail("integer overflow");
+            }
+            Ratio value;
+            value.set_numerator((long long)(n));
+            value.set_denominator((long long)(d));
+            return value;
+        }
+
+        Ratio add(const Ratio& a, const Ratio& b) const
+        {
+            return make((__int128)(a.get_numerator()) * b.get_denominator() + (__int128)(b.get_numerator()) * a.get_denominator(),
+                        (__int128)(a.get_denominator()) * b.get_denominator());
+        }
+
+        Ratio negate(const Ratio& a) const
+        {
+            return make(-(__int128)(a.get_numerator()), a.get_denominator());
+        }
+
+        Ratio multiply(const Ratio& a, const Ratio& b) const
+        {
+            return make((__int128)(a.get_numerator()) * b.get_numerator(), (__int128)(a.get_denominator()) * b.get_denominator());
+        }
+
+        /// \brief a / b, b can't be 0
+        Ratio divide(const Ratio& a, const Ratio& b) const
+        {
+            return make((__int128)(a.get_numerator()) * b.get_denominator(), (__int128)(a.get_denominator()) * b.get_numerator());
+        }
+
+        /// \brief a^n by squaring, at most 2 log2(n) checked products (|a| > 1 or |1/a| > 1 overflows within 64 squarings)
+        Ratio raise(Ratio a, unsigned long long n) const
+        {
+            Ratio result(1, 1);
+            while (n != 0)
+            {
+                if (n & 1)
+                {
+                    result = multiply(result, a);
+                }
+                n >>= 1;
+                if (n != 0)
+                {
+                    a = multiply(a, a);
+                }
+            }
+            return result;
+        }
+
+        /// \brief convert_real_to_ratio on the checked operations : the same continued fraction, an overflow is an error
+        Ratio convert(const double real, const uint nb_iter) const
+        {
+            const double magnitude = std::abs(real);
+            if (magnitude == 0 || nb_iter == 0)
+            {
+                return Ratio();
+            }
+            if (magnitude < 1)
+            {
+                return divide(Ratio(1, 1), convert(1 / real, nb_iter));
+            }
+            const double integer_part = std::floor(magnitude);
+            double floating_part = magnitude - integer_part;
+            if (floating_part < default_error_value)
+            {
+                floating_part = 0;
+            }
+            if (!(integer_part < 0x1p63))
+            {
+                fail("integer overflow");
+            }
+            const long long integer = (long long)(integer_part) * (real < 0 ? -1 : 1);
+            return add(Ratio(integer, 1), convert((real < 0 ? -floating_part : floating_part), nb_iter - 1));
+        }
+
+        void skip_spaces()
+        {
+            while (m_position < m_line.size() && (m_line[m_position] == ' ' || m_line[m_position] == '\t'))
+            {
+                ++m_position;
+            }
+        }
+
+        bool accept(const char c)
+        {
+            skip_spaces();
+            if (m_position < m_line.size() && m_line[m_position] == c)
+            {
+                ++m_position;
+                return true;
+            }
+            return false;
+        }
+
+        // expression := term (('+' | '-') term)*
+        Ratio expression()
+        {
+            Ratio value = term();
+            while (true)
+            {
+                if (accept('+'))
+                {
+                    value = add(value, term());
+                }
+                else if (accept('-'))
+                {
+                    value = add(value, negate(term()));
+                }
+                else
+                {
+                    return value;
+                }
+            }
+        }
+
+        // term := power (('*' | '/') power)*
+        Ratio term()
+        {
+            Ratio value = power();
+            while (true)
+            {
+                if (accept('*'))
+                {
+                    value = multiply(value, power());
+                }
+                else if (accept('/'))
+                {
+                    Ratio divisor = power();
+                    if (divisor.get_numerator() == 0)
+                    {
+                        fail("division by 0");
+                    }
+                    value = divide(value, divisor);
+                }
+                else
+                {
+                    return value;
+                }
+            }
+        }
+
+        // power := unary ('^' integer)?
+        Ratio power()
+        {
+            Ratio value = unary();
+            if (accept('^'))
+            {
+                skip_spaces();
+                bool negative = accept('-');
+                skip_spaces();
+                long long exponent = 0;
+                auto [end, error] = std::from_chars(m_line.data() + m_position, m_line.data() + m_line.size(), exponent);
+                if (error == std::errc::result_out_of_range)
+                {
+                    fail("exponent too large");
+                }
+                if (error != std::errc() || exponent < 0)
+                {
+                    fail("integer exponent expected");
+                }
+                m_position = size_t(end - m_line.data());
+                if (negative)
+                {
+                    if (value.get_numerator() == 0)
+                    {
+                        fail("division by 0");
+                    }
+                    value = divide(Ratio(1, 1), value);
+                }
+                value = raise(value, (unsigned long long)(exponent));
+            }
+            return value;
+        }
+
+        // unary := ('-' | '+') unary | primary
+        Ratio unary()
+        {
+            if (accept('-'))
+            {
+                return negate(unary());
+            }
+            if (accept('+'))
+            {
+                return unary();
+            }
+            return primary();
+        }
+
+        // primary := number | '(' expression ')'
+        Ratio primary()
+        {
+            if (accept('('))
+            {
+                Ratio value = expression();
+                if (!accept(')'))
+                {
+                    fail("')' expected");
+                }
+                return value;
+            }
+            skip_spaces();
+            const char* begin = m_line.data() + m_position;
+            const char* end = m_line.data() + m_line.size();
+            const char* digits_end = begin;
+            while (digits_end != end && *digits_end >= '0' && *digits_end <= '9')
+            {
+                ++digits_end;
+            }
+            if (digits_end == end || (*digits_end != '.' && *digits_end != 'e' && *digits_end != 'E'))
+            {
+                long long integer = 0;
+                auto [integer_end, error] = std::from_chars(begin, end, integer);
+                if (error == std::errc::result_out_of_range)
+                {
+                    fail("integer too large");
+                }
+                if (error != std::errc())
+                {
+                    fail("number expected");
+                }
+                m_position += size_t(integer_end - begin);
+                return Ratio(integer, 1);
+            }
+            // decimal or scientific literal, the library's continued fraction with checked operations
+            char* real_end = nullptr;
+            double real = std::strtod(begin, &real_end);
+            if (real_end == begin)
+            {
+                fail("number expected");
+            }
+            if (!(std::abs(real) < 0x1p63))
+            {
+                fail("number too large");
+            }
+            Ratio value = convert(real, m_nb_iter);
+            m_position += size_t(real_end - begin);
+            return value;
+        }
+};
+
+/// \class WorkerPool
+/// \brief fixed set of threads running batches of tasks
+class WorkerPool
+{
+    public:
+        explicit WorkerPool(const size_t nb_threads)
+        {
+            for (size_t i = 0; i < nb_threads; ++i)
+            {
+                m_threads.emplace_back([this]() { work(); });
+            }
+        }
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_task_ready.notify_all();
+            for (std::thread& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        /// \brief run every task on the pool and wait for all of them
+        void run(std::vector<std::function<void()>>& tasks)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (std::function<void()>& task : tasks)
+                {
+                    m_tasks.push(std::move(task));
+                }
+                m_pending += tasks.size();
+            }
+            m_task_ready.notify_all();
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_all_done.wait(lock, [this]() { return m_pending == 0; });
+        }
+
+    private:
+        std::vector<std::thread> m_threads; /**< workers */
+        std::queue<std::function<void()>> m_tasks; /**< tasks not started yet */
+        std::mutex m_mutex; /**< guards the queue, the counter and the stop flag */
+        std::condition_variable m_task_ready; /**< a task was pushed or the pool stops */
+        std::condition_variable m_all_done; /**< the last pending task finished */
+        size_t m_pending = 0; /**< tasks pushed and not finished */
+        bool m_stop = false; /**< workers exit once set */
+
+        void work()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_task_ready.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+                    if (m_stop && m_tasks.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop();
+                }
+                task();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_pending == 0)
+                {
+                    m_all_done.notify_all();
+                }
+            }
+        }
+};
+
+/// \class LineReader
+/// \brief reads the inputs one after the other in batches of lines, with large stream buffers
+class LineReader
+{
+    public:
+        explicit LineReader(const std::vector<std::string>& files) : m_files(files), m_buffer(1 << 20)
+        {
+            if (m_files.empty())
+            {
+                m_files.push_back("-");
+            }
+        }
+
+        /// \brief fill lines with up to max_lines lines, return false once every input is exhausted and lines is empty
+        /// throws std::runtime_error if a file can't be opened
+        bool read(std::vector<std::string>& lines, const size_t max_lines)
+        {
+            lines.clear();
+            while (lines.size() < max_lines)
+            {
+                if (!m_input && !open_next())
+                {
+                    break;
+                }
+                std::string line;
+                if (!std::getline(*m_input, line))
+                {
+                    m_input = nullptr;
+                    m_file.close();
+                    continue;
+                }
+                if (!line.empty() && line.back() == '\r')
+                {
+                    line.pop_back();
+                }
+                lines.push_back(std::move(line));
+            }
+            return !lines.empty();
+        }
+
+    private:
+        std::vector<std::string> m_files; /**< inputs, "-" is stdin */
+        size_t m_next_file = 0; /**< next input to open */
+        std::vector<char> m_buffer; /**< stream buffer of the open file */
+        std::ifstream m_file; /**< open file */
+        std::istream* m_input = nullptr; /**< stream being read */
+
+        bool open_next()
+        {
+            if (m_next_file == m_files.size())
+            {
+                return false;
+            }
+            const std::string& name = m_files[m_next_file++];
+            if (name == "-")
+            {
+                m_input = &std::cin;
+                return true;
+            }
+            m_file = std::ifstream();
+            m_file.rdbuf()->pubsetbuf(m_buffer.data(), std::streamsize(m_buffer.size()));
+            m_file.open(name);
+            if (!m_file)
+            {
+                throw std::runtime_error("unable to open " + name);
+            }
+            m_input = &m_file;
+            return true;
+        }
+};
+
+/// \brief evaluate one line and append its result to out
+void process_line(const std::string& line, const Settings& settings, std::string& out)
+{
+    bool blank = (line.find_first_not_of(" \t") == std::string::npos);
+    char status = (blank ? 2 : 0);
+    Ratio value;
+    std::string error;
+    if (!blank)
+    {
+        try
+        {
+            value = ExpressionParser(line, settings.nb_iter).evaluate();
+            if (settings.max_denominator > 0)
+            {
+                value = limit_denominator(value, settings.max_denominator);
+            }
+        }
+        catch (const std::exception& exception)
+        {
+            status = 1;
+            error = exception.what();
+        }
+    }
+
+    if (settings.format == Format::binary)
+    {
+        long long numerator = value.get_numerator();
+        long long denominator = value.get_denominator();
+        out.push_back(status);
+        out.append(reinterpret_cast<const char*>(&numerator), sizeof(numerator));
+        out.append(reinterpret_cast<const char*>(&denominator), sizeof(denominator));
+        return;
+    }
+    if (status == 1)
+    {
+        out += "error: ";
+        out += error;
+    }
+    else if (status == 0)
+    {
+        out += std::to_string(value.get_numerator());
+        out += '/';
+        out += std::to_string(value.get_denominator());
+    }
+    out += '\n';
+}
+
+void print_usage(std::ostream& stream)
+{
+    stream << "usage : ratio_batch [options] [files...]\n"
+           << "reads one number, fraction or expression (+ - * / ^ and parentheses) per line, from stdin when no file is given,\n"
+           << "and writes its irreducible fraction, in the same order\n\n"
+           << "  --iterations N       iterations of convert_real_to_ratio for decimal literals (default " << default_nb_iter << ")\n"
+           << "  --error E            floating parts under E are dropped by the conversion (default " << default_error_value << ")\n"
+           << "  --max-denominator D  round every result to its best approximation with a denominator <= D\n"
+           << "  --binary             17 bytes records : status (0 value, 1 error, 2 blank), numerator, denominator (native int64)\n"
+           << "  --threads N          worker threads (default : hardware threads)\n"
+           << "  --batch N            lines per buffer (default 8192)\n"
+           << "  --throughput         report lines/s and the precision settings on stderr\n"
+           << "  --help               print this message" << std::endl;
+}
+
+/// \brief parse the command line, return false (after printing why) if it is invalid
+bool parse_arguments(int argc, char** argv, Settings& settings)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        auto value = [&]() -> std::string
+        {
+            if (i + 1 == argc)
+            {
+                throw std::invalid_argument(argument + " needs a value");
+            }
+            return argv[++i];
+        };
+        try
+        {
+            if (argument == "--iterations")
+            {
+                settings.nb_iter = uint(std::stoul(value()));
+            }
+            else if (argument == "--error")
+            {
+                settings.error_value = std::stof(value());
+            }
+            else if (argument == "--max-denominator")
+            {
+                settings.max_denominator = std::stoll(value());
+            }
+            else if (argument == "--binary")
+            {
+                settings.format = Format::binary;
+            }
+            else if (argument == "--threads")
+            {
+                settings.nb_threads = std::max<size_t>(1, std::stoul(value()));
+            }
+            else if (argument == "--batch")
+            {
+                settings.batch_lines = std::max<size_t>(1, std::stoul(value()));
+            }
+            else if (argument == "--throughput")
+            {
+                settings.throughput = true;
+            }
+            else if (argument == "--help")
+            {
+                print_usage(std::cout);
+                std::exit(0);
+            }
+            else if (argument.size() > 1 && argument[0] == '-' && argument != "-")
+            {
+                throw std::invalid_argument("unknown option " + argument);
+            }
+            else
+            {
+                settings.files.push_back(argument);
+            }
+        }
+        catch (const std::exception& exception)
+        {
+            std::cerr << "ratio_batch : " << exception.what() << "\n\n";
+            print_usage(std::cerr);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::ios::sync_with_stdio(false);
+    Settings settings;
+    if (!parse_arguments(argc, argv, settings))
+    {
+        return 2;
+    }
+    default_error_value = settings.error_value;
+    std::setvbuf(stdout, nullptr, _IOFBF, 1 << 20);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t nb_lines = 0;
+    try
+    {
+        LineReader reader(settings.files);
+        WorkerPool pool(settings.nb_threads);
+
+        // double buffering : the next batch is read and the previous output written while the current batch is evaluated
+        std::vector<std::string> current, next;
+        std::string output, written;
+        std::future<void> writing;
+        reader.read(current, settings.batch_lines);
+        while (!current.empty())
+        {
+            std::future<bool> reading = std::async(std::launch::async, [&]() { return reader.read(next, settings.batch_lines); });
+
+            // one slice per worker, each one writing to its own string so the output keeps the input order
+            size_t nb_slices = std::min(settings.nb_threads, current.size());
+            std::vector<std::string> slices(nb_slices);
+            std::vector<std::function<void()>> tasks;
+            for (size_t s = 0; s < nb_slices; ++s)
+            {
+                tasks.push_back([&, s]()
+                {
+                    size_t first = s * current.size() / nb_slices;
+                    size_t last = (s + 1) * current.size() / nb_slices;
+                    for (size_t i = first; i < last; ++i)
+                    {
+                        process_line(current[i], settings, slices[s]);
+                    }
+                });
+            }
+            pool.run(tasks);
+            nb_lines += current.size();
+            output.clear();
+            for (const std::string& slice : slices)
+            {
+                output += slice;
+            }
+
+            if (writing.valid())
+            {
+                writing.get();
+            }
+            std::swap(output, written);
+            writing = std::async(std::launch::async, [&written]()
+            {
+                std::fwrite(written.data(), 1, written.size(), stdout);
+            });
+
+            reading.get();
+            std::swap(current, next);
+        }
+        if (writing.valid())
+        {
+            writing.get();
+        }
+        std::fflush(stdout);
+    }
+    catch (const std::exception& exception)
+    {
+        std::fflush(stdout);
+        std::cerr << "ratio_batch : " << exception.what() << std::endl;
+        return 1;
+    }
+
+    if (settings.throughput)
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << "lines " << nb_lines << "\n"
+                  << "seconds " << seconds << "\n"
+                  << "lines_per_second " << (seconds > 0 ? double(nb_lines) / seconds : 0.0) << "\n"
+                  << "threads " << settings.nb_threads << "\n"
+                  << "batch_lines " << settings.batch_lines << "\n"
+                  << "nb_iter " << settings.nb_iter << "\n"
+                  << "error_value " << settings.error_value << "\n"
+                  << "max_denominator " << settings.max_denominator << std::endl;
+    }
+    return 0;
+}
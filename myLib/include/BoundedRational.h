@@ -0,0 +1,410 @@
+#ifndef BoundedRational_H
+#define BoundedRational_H
+
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Rational.h"
+
+/// \enum RoundingMode
+/// \brief how the exact result of a BoundedRational operation is rounded to a fraction with a bounded denominator
+enum class RoundingMode
+{
+    nearest, /**< the closest fraction, the smaller denominator on a tie (the even one between 2 integers) */
+    down, /**< the largest fraction lower than or equal to the exact result */
+    up, /**< the smallest fraction greater than or equal to the exact result */
+    toward_zero /**< down for a positive result, up for a negative one */
+};
+
+/// \namespace bounded_detail
+/// \brief exact intermediate results on 128 bits
+namespace bounded_detail
+{
+    using Wide = __int128;
+
+    /// \brief return a * b, throws std::overflow_error if it doesn't fit in Wide
+    inline Wide checked_mul(const Wide& a, const Wide& b)
+    {
+        Wide result;
+        if (__builtin_mul_overflow(a, b, &result))
+        {
+            throw std::overflow_error("integer overflow");
+        }
+        return result;
+    }
+
+    /// \brief return a + b, throws std::overflow_error if it doesn't fit in Wide
+    inline Wide checked_add(const Wide& a, const Wide& b)
+    {
+        Wide result;
+        if (__builtin_add_overflow(a, b, &result))
+        {
+            throw std::overflow_error("integer overflow");
+        }
+        return result;
+    }
+
+    /// \brief return base^n by square and multiply, throws std::overflow_error if it doesn't fit in Wide
+    inline Wide checked_pow(Wide base, unsigned int n)
+    {
+        Wide result = 1;
+        for (; n != 0; n >>= 1)
+        {
+            if (n & 1)
+            {
+                result = checked_mul(result, base);
+            }
+            if (n > 1)
+            {
+                base = checked_mul(base, base);
+            }
+        }
+        return result;
+    }
+
+    /// \brief return floor(a / b) for b > 0
+    inline Wide floor_div(const Wide& a, const Wide& b)
+    {
+        Wide quotient = a / b;
+        return (a % b != 0 && a < 0 ? quotient - 1 : quotient);
+    }
+
+    /// \brief the double just above x, error bounds must stay upper bounds
+    inline double upper(const long double& x)
+    {
+        double result = double(x * (1 + 4 * std::numeric_limits<long double>::epsilon()));
+        return (result < x ? std::nextafter(result, std::numeric_limits<double>::infinity()) : result);
+    }
+}
+
+/// \class BoundedRational
+/// \brief Rational whose denominator never exceeds MaxDen : every operation computes its exact result on 128 bits and rounds it
+/// to the nearest fraction with a denominator <= MaxDen (continued fraction best approximation), or in a chosen direction
+/// \details the cost of an operation and the size of a value are fixed, and each value carries a bound on its distance to the
+/// result the same computation would give in exact arithmetic (the roundings and their propagation through the operations).
+/// MaxDen is at most 2^31 so that the exact intermediate results of a T of up to 64 bits fit in 128 bits
+/// \tparam T : int
+/// \tparam MaxDen : largest denominator
+template<typename T, T MaxDen>
+class BoundedRational
+{
+    static_assert(std::is_integral_v<T> && sizeof(T) <= 8, "type must be int");
+    static_assert(MaxDen > 0 && (long long)(MaxDen) <= (1LL << 31), "max denominator must be in [1, 2^31]");
+
+    using Wide = bounded_detail::Wide;
+
+    public:
+        /// \brief largest denominator
+        static constexpr T max_denominator = MaxDen;
+
+        //constructors
+
+        /// \brief default constructor with value of 0/1
+        BoundedRational() : m_numerator(0), m_denominator(1), m_error(0) {}
+
+        /// \brief value constructor, rounds numerator / denominator if the denominator is over MaxDen
+        /// \param numerator : numerator
+        /// \param denominator : denominator, throws std::invalid_argument if it is 0
+        /// \param mode : rounding mode
+        BoundedRational(const T& numerator, const T& denominator = T(1), const RoundingMode mode = RoundingMode::nearest)
+        {
+            if (denominator == 0)
+            {
+                throw std::invalid_argument("denominator can't be equal to 0");
+            }
+            *this = round(numerator, denominator, mode, 0);
+        }
+
+        /// \brief Rational constructor, rounds the Rational if its denominator is over MaxDen
+        /// \param ratio : exact value
+        /// \param mode : rounding mode
+        BoundedRational(const Rational<T>& ratio, const RoundingMode mode = RoundingMode::nearest)
+            : BoundedRational(ratio.get_numerator(), ratio.get_denominator(), mode) {}
+
+        /// \brief default destructor
+        ~BoundedRational() = default;
+
+    private:
+        T m_numerator; /**< numerator */
+        T m_denominator; /**< denominator, in [1, MaxDen] */
+        double m_error; /**< bound on the distance to the exact result */
+
+        /// \brief return numerator / denominator rounded to a denominator <= MaxDen, error is the bound inherited from the operands
+        /// \details the convergents p/q of the value are computed while q <= MaxDen, then the last convergent and the largest
+        /// semiconvergent (p0 + k p) / (q0 + k q) with a denominator <= MaxDen are the 2 neighbors of the value among the
+        /// fractions of denominator <= MaxDen (Farey neighbors), one on each side. With x = (p n + p0 d) / (q n + q0 d) for the
+        /// remainders n, d of Euclid's algorithm, their distances to the value are d / (q (q n + q0 d)) and
+        /// (n - k d) / ((q0 + k q) (q n + q0 d)), compared without any product of the (possibly large) exact terms
+        static BoundedRational round(Wide numerator, Wide denominator, const RoundingMode mode, const long double& error)
+        {
+            using namespace bounded_detail;
+            if (denominator < 0)
+            {
+                numerator = -numerator;
+                denominator = -denominator;
+            }
+            Wide p0 = 0, q0 = 1, p = 1, q = 0;
+            Wide n = numerator, d = denominator;
+            while (true)
+            {
+                Wide a = floor_div(n, d);
+                Wide next_q = checked_add(q0, checked_mul(a, q));
+                if (next_q > Wide(MaxDen))
+                {
+                    break;
+                }
+                Wide next_p = checked_add(p0, checked_mul(a, p));
+                p0 = p;
+                q0 = q;
+                p = next_p;
+                q = next_q;
+                Wide remainder = n - a * d;
+                n = d;
+                d = remainder;
+                if (d == 0)
+                {
+                    return make(p, q, error);
+                }
+            }
+
+            const Wide k = (Wide(MaxDen) - q0) / q;
+            const Wide semi_p = checked_add(p0, checked_mul(k, p)), semi_q = q0 + k * q;
+            const Wide rest = n - k * d; // > 0 since the next partial quotient is over k
+            const long double scale = (long double)(q) * (long double)(n) + (long double)(q0) * (long double)(d);
+            // x - p/q = (p0 q - p q0) / (q (q n + q0 d)) : the convergent is below the value iff p q0 < p0 q
+            const bool convergent_below = (checked_mul(p, q0) < checked_mul(p0, q));
+            bool convergent;
+            switch (mode)
+            {
+                case RoundingMode::nearest:
+                {
+                    Wide convergent_side = d * semi_q, semi_side = rest * q;
+                    if (convergent_side != semi_side)
+                    {
+                        convergent = convergent_side < semi_side;
+                    }
+                    else
+                    {
+                        convergent = (q != semi_q ? q < semi_q : p % 2 == 0);
+                    }
+                    break;
+                }
+                case RoundingMode::down:
+                    convergent = convergent_below;
+                    break;
+                case RoundingMode::up:
+                    convergent = !convergent_below;
+                    break;
+                default:
+                    convergent = (numerator >= 0 ? convergent_below : !convergent_below);
+                    break;
+            }
+            if (convergent)
+            {
+                return make(p, q, error + (long double)(d) / ((long double)(q) * scale));
+            }
+            return make(semi_p, semi_q, error + (long double)(rest) / ((long double)(semi_q) * scale));
+        }
+
+        /// \brief build the value from an irreducible fraction (convergents are), throws std::overflow_error if it doesn't fit in T
+        static BoundedRational make(const Wide& numerator, const Wide& denominator, const long double& error)
+        {
+            if (numerator > Wide(std::numeric_limits<T>::max()) || numerator < Wide(std::numeric_limits<T>::min()))
+            {
+                throw std::overflow_error("result doesn't fit in the type");
+            }
+            BoundedRational result;
+            result.m_numerator = T(numerator);
+            result.m_denominator = T(denominator);
+            result.m_error = bounded_detail::upper(error);
+            return result;
+        }
+
+        /// \brief |value| as a long double
+        long double magnitude() const { return std::fabs((long double)(m_numerator) / (long double)(m_denominator)); }
+
+    public:
+        //Functions
+
+        /// \brief return the numerator
+        T get_numerator() const { return m_numerator; }
+
+        /// \brief return the denominator, never over MaxDen
+        T get_denominator() const { return m_denominator; }
+
+        /// \brief return the bound on |value - exact result| accumulated by the roundings of the operations that built this value
+        double error() const { return m_error; }
+
+        /// \brief return the value as a Rational
+        Rational<T> to_rational() const { return Rational<T>(m_numerator, m_denominator); }
+
+        /// \brief return the double value of the fraction
+        double get_value() const { return double(m_numerator) / double(m_denominator); }
+
+        /// \brief return the same value with no accumulated error (a new exact starting point)
+        BoundedRational exact() const
+        {
+            BoundedRational result = *this;
+            result.m_error = 0;
+            return result;
+        }
+
+        /// \brief sum rounded in the given direction
+        /// \param other : the BoundedRational we want to sum with
+        /// \param mode : rounding mode
+        BoundedRational add(const BoundedRational& other, const RoundingMode mode = RoundingMode::nearest) const
+        {
+            return round(Wide(m_numerator) * other.m_denominator + Wide(other.m_numerator) * m_denominator,
+                         Wide(m_denominator) * other.m_denominator, mode, (long double)(m_error) + other.m_error);
+        }
+
+        /// \brief subtraction rounded in the given direction
+        /// \param other : the BoundedRational we want to substract
+        /// \param mode : rounding mode
+        BoundedRational subtract(const BoundedRational& other, const RoundingMode mode = RoundingMode::nearest) const
+        {
+            return round(Wide(m_numerator) * other.m_denominator - Wide(other.m_numerator) * m_denominator,
+                         Wide(m_denominator) * other.m_denominator, mode, (long double)(m_error) + other.m_error);
+        }
+
+        /// \brief multiplication rounded in the given direction, the errors propagate as |a| eb + |b| ea + ea eb
+        /// \param other : the BoundedRational we want to multiply with
+        /// \param mode : rounding mode
+        BoundedRational multiply(const BoundedRational& other, const RoundingMode mode = RoundingMode::nearest) const
+        {
+            long double error = magnitude() * other.m_error + other.magnitude() * m_error + (long double)(m_error) * other.m_error;
+            return round(Wide(m_numerator) * other.m_numerator, Wide(m_denominator) * other.m_denominator, mode, error);
+        }
+
+        /// \brief division rounded in the given direction, the errors propagate as (|b| ea + |a| eb) / (|b| (|b| - eb)),
+        /// infinite if eb >= |b| (the exact divisor may be 0)
+        /// \param other : the BoundedRational we want to divide with, throws std::invalid_argument if it is 0
+        /// \param mode : rounding mode
+        BoundedRational divide(const BoundedRational& other, const RoundingMode mode = RoundingMode::nearest) const
+        {
+            if (other.m_numerator == 0)
+            {
+                throw std::invalid_argument("division by 0");
+            }
+            const long double b = other.magnitude();
+            long double error = (other.m_error < b ? (b * m_error + magnitude() * other.m_error) / (b * (b - other.m_error))
+                                                   : std::numeric_limits<long double>::infinity());
+            return round(Wide(m_numerator) * other.m_denominator, Wide(m_denominator) * other.m_numerator, mode, error);
+        }
+
+        /// \brief power rounded in the given direction, the exact power is rounded once when it fits in 128 bits, otherwise
+        /// every step of the square and multiply is rounded (in the direction that keeps the result on the requested side)
+        /// \param n : the power
+        /// \param mode : rounding mode
+        BoundedRational pow(const unsigned int& n, const RoundingMode mode = RoundingMode::nearest) const
+        {
+            using namespace bounded_detail;
+            const long double inherited = (m_error == 0 ? 0 : std::pow(magnitude() + m_error, (long double)(n)) - std::pow(magnitude(), (long double)(n)));
+            try
+            {
+                const Wide numerator = checked_pow(Wide(m_numerator), n), denominator = checked_pow(Wide(m_denominator), n);
+                // the remainders of the rounding are below the denominator, their products with MaxDen must fit too
+                if (denominator > (Wide(1) << 94))
+                {
+                    throw std::overflow_error("power too large to be rounded once");
+                }
+                return round(numerator, denominator, mode, inherited);
+            }
+            catch (const std::overflow_error&)
+            {
+                // |x|^n rounded on the side that gives the requested direction once the sign is applied
+                const bool negative = (m_numerator < 0 && n % 2 == 1);
+                RoundingMode magnitude_mode = mode;
+                if (mode == RoundingMode::toward_zero)
+                {
+                    magnitude_mode = RoundingMode::down;
+                }
+                else if (negative && mode != RoundingMode::nearest)
+                {
+                    magnitude_mode = (mode == RoundingMode::down ? RoundingMode::up : RoundingMode::down);
+                }
+                BoundedRational base = (m_numerator < 0 ? -*this : *this);
+                BoundedRational result(T(1));
+                for (unsigned int e = n; e != 0; e >>= 1)
+                {
+                    if (e & 1)
+                    {
+                        result = result.multiply(base, magnitude_mode);
+                    }
+                    if (e > 1)
+                    {
+                        base = base.multiply(base, magnitude_mode);
+                    }
+                }
+                return (negative ? -result : result);
+            }
+        }
+
+        /// \brief return the absolute value
+        BoundedRational abs() const { return (m_numerator < 0 ? -*this : *this); }
+
+        //Operators
+
+        /// \brief unary minus operator, exact
+        BoundedRational operator-() const
+        {
+            BoundedRational result = *this;
+            result.m_numerator = -m_numerator;
+            return result;
+        }
+
+        /// \brief sum of 2 BoundedRational, rounded to the nearest
+        BoundedRational operator+(const BoundedRational& other) const { return add(other); }
+
+        /// \brief subtraction of 2 BoundedRational, rounded to the nearest
+        BoundedRational operator-(const BoundedRational& other) const { return subtract(other); }
+
+        /// \brief multiplication of 2 BoundedRational, rounded to the nearest
+        BoundedRational operator*(const BoundedRational& other) const { return multiply(other); }
+
+        /// \brief division of 2 BoundedRational, rounded to the nearest
+        BoundedRational operator/(const BoundedRational& other) const { return divide(other); }
+
+        /// \brief add a BoundedRational with the called BoundedRational and affect it
+        void operator+=(const BoundedRational& other) { *this = add(other); }
+
+        /// \brief substract a BoundedRational with the called BoundedRational and affect it
+        void operator-=(const BoundedRational& other) { *this = subtract(other); }
+
+        /// \brief multiply a BoundedRational with the called BoundedRational and affect it
+        void operator*=(const BoundedRational& other) { *this = multiply(other); }
+
+        /// \brief divide a BoundedRational with the called BoundedRational and affect it
+        void operator/=(const BoundedRational& other) { *this = divide(other); }
+
+        /// \brief equality of the values (the errors are not compared)
+        bool operator==(const BoundedRational& other) const { return m_numerator == other.m_numerator && m_denominator == other.m_denominator; }
+
+        /// \brief difference of the values
+        bool operator!=(const BoundedRational& other) const { return !(*this == other); }
+
+        /// \brief strictly lower operator, exact
+        bool operator<(const BoundedRational& other) const { return Wide(m_numerator) * other.m_denominator < Wide(other.m_numerator) * m_denominator; }
+
+        /// \brief strictly greater operator, exact
+        bool operator>(const BoundedRational& other) const { return other < *this; }
+
+        /// \brief lower or equal operator, exact
+        bool operator<=(const BoundedRational& other) const { return !(other < *this); }
+
+        /// \brief greater or equal operator, exact
+        bool operator>=(const BoundedRational& other) const { return !(*this < other); }
+};
+
+/// \brief overload the << operator for BoundedRational
+template<typename T, T MaxDen>
+std::ostream& operator<<(std::ostream& stream, const BoundedRational<T, MaxDen>& ratio)
+{
+    stream << ratio.get_numerator() << "/" << ratio.get_denominator();
+    return stream;
+}
+
+#endif
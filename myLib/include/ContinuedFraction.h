@@ -0,0 +1,671 @@
+#ifndef ContinuedFraction_H
+#define ContinuedFraction_H
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "Rational.h"
+
+/// \class ContinuedFraction
+/// \brief lazy stream of the partial quotients [a0; a1, a2, ...] of a real number
+/// \details terms are produced on demand by a generator and kept, so only the terms that are read are computed.
+/// Copies share the same stream. Arithmetic between streams uses Gosper's bihomographic algorithm, the result is itself a lazy stream.
+/// Quadratic irrationals (sqrt of a non square Rational) are exact periodic streams.
+/// A stream is not thread safe.
+/// \tparam T : int, long long is advised since the arithmetic states grow fast
+template<typename T = long long>
+class ContinuedFraction
+{
+    public:
+        /// \brief a generator returns the next partial quotient, or std::nullopt when the expansion is finite and over
+        using Generator = std::function<std::optional<T>()>;
+
+        //constructors
+
+        /// \brief stream built from a generator
+        /// \tparam T : int
+        /// \tparam F : callable returning std::optional<T>
+        /// \param generator : returns the partial quotients one by one
+        template<typename F, typename = std::enable_if_t<std::is_invocable_r_v<std::optional<T>, F&>>>
+        explicit ContinuedFraction(F generator) : m_stream(std::make_shared<Stream>())
+        {
+            static_assert(std::is_integral_v<T>, "type must be int");
+            m_stream->generator = Generator(std::move(generator));
+        }
+
+        /// \brief exact expansion of a Rational (Euclid's algorithm, computed lazily)
+        /// \tparam T : int
+        /// \param ratio : Rational to expand, its denominator can't be 0
+        explicit ContinuedFraction(const Rational<T>& ratio) : ContinuedFraction(euclid(ratio.get_numerator(), ratio.get_denominator()))
+        {
+            if (ratio.get_denominator() == 0)
+            {
+                throw std::invalid_argument("denominator can't be equal to 0");
+            }
+        }
+
+        /// \brief finite expansion from a list of partial quotients
+        /// \tparam T : int
+        /// \param terms : a0, a1, ... where all the terms but a0 must be strictly positive
+        static ContinuedFraction from_terms(const std::vector<T>& terms)
+        {
+            return periodic(terms, {});
+        }
+
+        /// \brief periodic expansion [prefix; period, period, ...], finite if period is empty
+        /// \tparam T : int
+        /// \param prefix : first terms
+        /// \param period : terms repeated forever after the prefix
+        static ContinuedFraction periodic(const std::vector<T>& prefix, const std::vector<T>& period)
+        {
+            size_t i = 0;
+            return ContinuedFraction([prefix, period, i]() mutable -> std::optional<T>
+            {
+                if (i < prefix.size())
+                {
+                    return prefix[i++];
+                }
+                if (period.empty())
+                {
+                    return std::nullopt;
+                }
+                return period[(i++ - prefix.size()) % period.size()];
+            });
+        }
+
+        /// \brief expansion of a floating point value, stops like convert_real_to_ratio when the floating part is under default_error_value
+        /// \tparam U : floating point
+        /// \param real : value to expand
+        /// \param nb_iter : maximum number of terms
+        template<typename U>
+        static ContinuedFraction from_real(const U& real, const uint nb_iter = default_nb_iter)
+        {
+            static_assert(std::is_floating_point_v<U>, "type must be floating point");
+            U value = real;
+            uint i = 0;
+            bool over = false;
+            return ContinuedFraction([value, i, nb_iter, over]() mutable -> std::optional<T>
+            {
+                if (over || i++ == nb_iter)
+                {
+                    return std::nullopt;
+                }
+                U integer_part = std::floor(value);
+                U floating_part = value - integer_part;
+                if (floating_part < default_error_value)
+                {
+                    over = true;
+                }
+                else
+                {
+                    value = 1 / floating_part;
+                }
+                return T(integer_part);
+            });
+        }
+
+        /// \brief exact periodic expansion of the square root of a positive Rational, finite if it is a perfect square
+        /// \details sqrt(p/q) = sqrt(p*q)/q, then the classic recurrence on the quadratic surd (P + sqrt(D))/Q whose terms stay bounded by 2*sqrt(D)
+        /// \tparam T : int
+        /// \param ratio : positive Rational
+        static ContinuedFraction sqrt(const Rational<T>& ratio)
+        {
+            if (ratio.get_numerator() < 0 || ratio.get_denominator() == 0)
+            {
+                throw std::invalid_argument("value must be positive");
+            }
+            T D = checked_mul(ratio.get_numerator(), ratio.get_denominator());
+            T root = isqrt(D);
+            if (root * root == D)
+            {
+                return ContinuedFraction(Rational<T>(root, ratio.get_denominator()));
+            }
+
+            T P = 0;
+            T Q = ratio.get_denominator();
+            return ContinuedFraction([D, root, P, Q]() mutable -> std::optional<T>
+            {
+                T a = (P + root) / Q;
+                P = a * Q - P;
+                Q = (D - P * P) / Q;
+                return a;
+            });
+        }
+
+    private:
+        /// \struct Stream
+        /// \brief shared state : the generator and the terms already produced
+        struct Stream
+        {
+            Generator generator;
+            std::vector<T> terms;
+            bool finished = false;
+        };
+
+        std::shared_ptr<Stream> m_stream; /**< shared lazy stream */
+
+    public:
+        //Functions
+
+        /// \brief return the i-th partial quotient (a0 is the 0-th), computing the missing ones, or std::nullopt if the expansion is shorter
+        /// \param i : index of the term
+        std::optional<T> term(const size_t i) const
+        {
+            while (m_stream->terms.size() <= i && !m_stream->finished)
+            {
+                std::optional<T> next = m_stream->generator();
+                if (next)
+                {
+                    m_stream->terms.push_back(*next);
+                }
+                else
+                {
+                    m_stream->finished = true;
+                    m_stream->generator = nullptr;
+                }
+            }
+            return (i < m_stream->terms.size() ? std::optional<T>(m_stream->terms[i]) : std::nullopt);
+        }
+
+        /// \brief return the first n partial quotients (less if the expansion is shorter)
+        /// \param n : number of terms
+        std::vector<T> terms(const size_t n) const
+        {
+            term(n == 0 ? 0 : n - 1);
+            return std::vector<T>(m_stream->terms.begin(), m_stream->terms.begin() + std::min(n, m_stream->terms.size()));
+        }
+
+        /// \brief return the number of partial quotients computed so far
+        size_t computed_terms() const { return m_stream->terms.size(); }
+
+        /// \brief return true if the generator already reported the end of the expansion, without computing any term
+        bool is_finished() const { return m_stream->finished; }
+
+        /// \brief return true if the expansion is finite and has at most n terms
+        /// \param n : number of terms that may be computed to find out
+        bool is_finite(const size_t n) const
+        {
+            return !term(n);
+        }
+
+        /// \brief return the n-th convergent p_n/q_n, or the exact value if the expansion has n terms or less
+        /// \param n : index of the convergent
+        Rational<T> convergent(const size_t n) const
+        {
+            T p = 1, q = 0, p_prev = 0, q_prev = 1;
+            for (size_t i = 0; i <= n; ++i)
+            {
+                std::optional<T> a = term(i);
+                if (!a)
+                {
+                    break;
+                }
+                advance_convergent(*a, p, q, p_prev, q_prev);
+            }
+            return make_normalized(p, q);
+        }
+
+        /// \brief return the exact Rational of a finite expansion
+        /// \param max_terms : throws if the expansion has more terms than that (infinite streams)
+        Rational<T> to_rational(const size_t max_terms = 1000) const
+        {
+            if (!is_finite(max_terms))
+            {
+                throw std::invalid_argument("expansion is infinite or too long to be converted");
+            }
+            return convergent(max_terms);
+        }
+
+        /// \brief return the first convergent closer than epsilon to the value, reading only the terms needed
+        /// \details |x - p_n/q_n| < 1/(q_n q_n+1), so we stop as soon as q_n q_n+1 >= 1/epsilon
+        /// \param epsilon : strictly positive error bound
+        Rational<T> approximate(const Rational<T>& epsilon) const
+        {
+            if (epsilon.get_numerator() <= 0)
+            {
+                throw std::invalid_argument("epsilon must be strictly positive");
+            }
+            T p = 1, q = 0, p_prev = 0, q_prev = 1;
+            for (size_t i = 0; ; ++i)
+            {
+                std::optional<T> a = term(i);
+                if (!a)
+                {
+                    return make_normalized(p, q);
+                }
+                advance_convergent(*a, p, q, p_prev, q_prev);
+                std::optional<T> next = term(i + 1);
+                if (!next)
+                {
+                    return make_normalized(p, q);
+                }
+                // q_n+1 >= a_n+1 * q_n, checked in long double to avoid overflowing T
+                long double bound = (long double)(q) * ((long double)(*next) * q + q_prev);
+                if (bound * epsilon.get_numerator() >= epsilon.get_denominator())
+                {
+                    return make_normalized(p, q);
+                }
+            }
+        }
+
+        /// \brief return the closest Rational whose denominator is at most max_denominator (best rational approximation)
+        /// \details last convergent with a small enough denominator, or the best semiconvergent between it and the next one
+        /// \param max_denominator : strictly positive bound
+        Rational<T> best_approximation(const T& max_denominator) const
+        {
+            if (max_denominator <= 0)
+            {
+                throw std::invalid_argument("max denominator must be strictly positive");
+            }
+            T p = 1, q = 0, p_prev = 0, q_prev = 1;
+            for (size_t i = 0; ; ++i)
+            {
+                std::optional<T> a = term(i);
+                if (!a)
+                {
+                    return make_normalized(p, q);
+                }
+                if (i > 0 && (max_denominator - q_prev) / q < *a)
+                {
+                    // the next convergent is too large : best semiconvergent k is max(k) with k q + q_prev <= max_denominator,
+                    // it is better than p/q only if 2k > a, or 2k == a and the tail decides (compare on the exact remainder)
+                    T k = (max_denominator - q_prev) / q;
+                    Rational<T> convergent_value = make_normalized(p, q);
+                    if (k == 0)
+                    {
+                        return convergent_value;
+                    }
+                    Rational<T> semiconvergent = make_normalized(checked_add(checked_mul(k, p), p_prev), checked_add(checked_mul(k, q), q_prev));
+                    if (2 * k > *a)
+                    {
+                        return semiconvergent;
+                    }
+                    if (2 * k < *a)
+                    {
+                        return convergent_value;
+                    }
+                    // 2k == a : the semiconvergent wins iff q_prev/q > [0; a_i+1, a_i+2, ...] (half rule)
+                    ContinuedFraction rest([self = *this, i, j = i]() mutable -> std::optional<T>
+                    {
+                        if (j == i)
+                        {
+                            ++j;
+                            return T(0);
+                        }
+                        return self.term(j++);
+                    });
+                    return (compare(ContinuedFraction(make_normalized(q_prev, q)), rest) > 0 ? semiconvergent : convergent_value);
+                }
+                advance_convergent(*a, p, q, p_prev, q_prev);
+            }
+        }
+
+        /// \brief compare the values of 2 streams term by term, return -1, 0 or 1
+        /// \details at the first differing term, a bigger term means a bigger value at even indices and a smaller one at odd indices,
+        /// a stream that is over counts as an infinite term
+        /// \param x : first stream
+        /// \param y : second stream
+        /// \param max_terms : the streams are considered equal if their first max_terms terms are
+        static int compare(const ContinuedFraction& x, const ContinuedFraction& y, const size_t max_terms = 1000)
+        {
+            for (size_t i = 0; i < max_terms; ++i)
+            {
+                std::optional<T> a = x.term(i);
+                std::optional<T> b = y.term(i);
+                if (!a && !b)
+                {
+                    return 0;
+                }
+                if (a != b)
+                {
+                    bool x_bigger_term = (!a || (b && *a > *b));
+                    return ((i % 2 == 0) == x_bigger_term ? 1 : -1);
+                }
+            }
+            return 0;
+        }
+
+        //Arithmetic
+
+        /// \brief Gosper's bihomographic transform z = (axy + bx + cy + d) / (exy + fx + gy + h) of two streams, computed lazily
+        /// \details when the coefficients don't fit in T anymore, reading the next term throws std::overflow_error : the terms
+        /// already produced stay exact, but the precision of the result is limited by T (an exact result of 2 irrational inputs,
+        /// like sqrt(2) * sqrt(2), needs infinitely many input terms and always throws)
+        /// \param x : first stream
+        /// \param y : second stream
+        /// \param coefficients : a, b, c, d, e, f, g, h
+        static ContinuedFraction bihomographic(const ContinuedFraction& x, const ContinuedFraction& y, const std::array<T, 8>& coefficients)
+        {
+            return ContinuedFraction(Gosper{x, y, coefficients});
+        }
+
+        /// \brief sum of 2 streams
+        ContinuedFraction operator+(const ContinuedFraction& other) const
+        {
+            return bihomographic(*this, other, {0, 1, 1, 0, 0, 0, 0, 1});
+        }
+
+        /// \brief subtraction of 2 streams
+        ContinuedFraction operator-(const ContinuedFraction& other) const
+        {
+            return bihomographic(*this, other, {0, 1, -1, 0, 0, 0, 0, 1});
+        }
+
+        /// \brief multiplication of 2 streams
+        ContinuedFraction operator*(const ContinuedFraction& other) const
+        {
+            return bihomographic(*this, other, {1, 0, 0, 0, 0, 0, 0, 1});
+        }
+
+        /// \brief division of 2 streams
+        ContinuedFraction operator/(const ContinuedFraction& other) const
+        {
+            return bihomographic(*this, other, {0, 1, 0, 0, 0, 0, 1, 0});
+        }
+
+        /// \brief sum with a Rational
+        ContinuedFraction operator+(const Rational<T>& ratio) const { return *this + ContinuedFraction(ratio); }
+
+        /// \brief subtraction with a Rational
+        ContinuedFraction operator-(const Rational<T>& ratio) const { return *this - ContinuedFraction(ratio); }
+
+        /// \brief multiplication with a Rational
+        ContinuedFraction operator*(const Rational<T>& ratio) const { return *this * ContinuedFraction(ratio); }
+
+        /// \brief division with a Rational
+        ContinuedFraction operator/(const Rational<T>& ratio) const { return *this / ContinuedFraction(ratio); }
+
+        //Integer helpers
+
+        /// \brief return floor(a / b) for any sign, b can't be 0
+        static constexpr T floor_div(const T& a, const T& b)
+        {
+            T q = a / b;
+            return ((a % b != 0) && ((a < 0) != (b < 0)) ? q - 1 : q);
+        }
+
+        /// \brief return the integer square root floor(sqrt(n)) of a positive integer
+        static T isqrt(const T& n)
+        {
+            T root = T(std::sqrt((long double)n));
+            while (root > 0 && root > n / root)
+            {
+                --root;
+            }
+            while ((root + 1) <= n / (root + 1))
+            {
+                ++root;
+            }
+            return root;
+        }
+
+        /// \brief return a * b, throws std::overflow_error if it doesn't fit in T
+        static T checked_mul(const T& a, const T& b)
+        {
+            T result;
+            if (__builtin_mul_overflow(a, b, &result))
+            {
+                throw std::overflow_error("integer overflow");
+            }
+            return result;
+        }
+
+        /// \brief return a + b, throws std::overflow_error if it doesn't fit in T
+        static T checked_add(const T& a, const T& b)
+        {
+            T result;
+            if (__builtin_add_overflow(a, b, &result))
+            {
+                throw std::overflow_error("integer overflow");
+            }
+            return result;
+        }
+
+        /// \brief return a - b, throws std::overflow_error if it doesn't fit in T
+        static T checked_sub(const T& a, const T& b)
+        {
+            T result;
+            if (__builtin_sub_overflow(a, b, &result))
+            {
+                throw std::overflow_error("integer overflow");
+            }
+            return result;
+        }
+
+    private:
+        /// \brief generator of the Euclid's algorithm on n/d
+        static Generator euclid(T n, T d)
+        {
+            return [n, d]() mutable -> std::optional<T>
+            {
+                if (d == 0)
+                {
+                    return std::nullopt;
+                }
+                T a = floor_div(n, d);
+                T r = n - a * d;
+                n = d;
+                d = r;
+                return a;
+            };
+        }
+
+        /// \brief p_n = a p_n-1 + p_n-2, throws std::overflow_error if it doesn't fit in T
+        static void advance_convergent(const T& a, T& p, T& q, T& p_prev, T& q_prev)
+        {
+            T p_next = checked_add(checked_mul(a, p), p_prev);
+            T q_next = checked_add(checked_mul(a, q), q_prev);
+            p_prev = p;
+            q_prev = q;
+            p = p_next;
+            q = q_next;
+        }
+
+        /// \brief build a Rational from an already irreducible fraction (convergents are), keeping the denominator positive
+        static Rational<T> make_normalized(const T& p, const T& q)
+        {
+            Rational<T> ratio;
+            ratio.set_numerator(q < 0 ? -p : p);
+            ratio.set_denominator(q < 0 ? -q : q);
+            return ratio;
+        }
+
+        /// \struct Gosper
+        /// \brief state of the bihomographic transform, called as a generator
+        struct Gosper
+        {
+            ContinuedFraction x; /**< first input */
+            ContinuedFraction y; /**< second input */
+            std::array<T, 8> s; /**< a, b, c, d, e, f, g, h */
+            size_t x_index = 0; /**< next term of x to ingest */
+            size_t y_index = 0; /**< next term of y to ingest */
+            bool x_over = false; /**< x has no more terms (x = infinity) */
+            bool y_over = false; /**< y has no more terms (y = infinity) */
+            bool over = false; /**< the output has no more terms */
+
+            std::optional<T> operator()()
+            {
+                while (!over)
+                {
+                    std::optional<T> q = try_emit();
+                    if (q)
+                    {
+                        return q;
+                    }
+                    if (over)
+                    {
+                        break;
+                    }
+                    ingest(choose_x());
+                }
+                return std::nullopt;
+            }
+
+            /// \brief corners of z for x, y in {inf, 0} (only the ones that still depend on a living input), as (numerator, denominator)
+            std::vector<std::pair<T, T>> corners() const
+            {
+                std::vector<std::pair<T, T>> result;
+                if (!x_over && !y_over) { result.emplace_back(s[0], s[4]); }
+                if (!x_over) { result.emplace_back(s[1], s[5]); }
+                if (!y_over) { result.emplace_back(s[2], s[6]); }
+                result.emplace_back(s[3], s[7]);
+                return result;
+            }
+
+            /// \brief emit the next term if every corner has the same integer part
+            std::optional<T> try_emit()
+            {
+                // an input must have given its first term : before that it can be any real, corners don't bound z
+                if ((!x_over && x_index == 0) || (!y_over && y_index == 0))
+                {
+                    return std::nullopt;
+                }
+                std::vector<std::pair<T, T>> c = corners();
+                bool all_zero = true;
+                for (const auto& corner : c)
+                {
+                    all_zero = all_zero && corner.second == 0;
+                }
+                if (all_zero)
+                {
+                    over = true;
+                    return std::nullopt;
+                }
+                for (const auto& corner : c)
+                {
+                    if (corner.second == 0 || (corner.second < 0) != (c[0].second < 0))
+                    {
+                        return std::nullopt;
+                    }
+                }
+                T q = floor_div(c[0].first, c[0].second);
+                for (const auto& corner : c)
+                {
+                    if (floor_div(corner.first, corner.second) != q)
+                    {
+                        return std::nullopt;
+                    }
+                }
+                // z = q + 1/z' : new numerator is the old denominator, new denominator is numerator - q * denominator
+                std::array<T, 8> next;
+                for (int i = 0; i < 4; ++i)
+                {
+                    next[i] = s[i + 4];
+                    next[i + 4] = checked_sub(s[i], checked_mul(q, s[i + 4]));
+                }
+                s = next;
+                return q;
+            }
+
+            /// \brief return true if the next term should be read from x, false for y
+            bool choose_x() const
+            {
+                if (x_over) { return false; }
+                if (y_over) { return true; }
+                if (x_index == 0) { return true; }
+                if (y_index == 0) { return false; }
+                // read from the input whose variation spreads the corners the most (a corner with a 0 denominator is infinite)
+                long double a = corner_value(s[0], s[4]);
+                long double b = corner_value(s[1], s[5]);
+                long double c = corner_value(s[2], s[6]);
+                long double d = corner_value(s[3], s[7]);
+                long double spread_x = std::max(spread(b, d), spread(a, c));
+                long double spread_y = std::max(spread(c, d), spread(a, b));
+                return !(spread_y > spread_x);
+            }
+
+            static long double corner_value(const T& n, const T& d)
+            {
+                return (d == 0 ? std::numeric_limits<long double>::infinity() : (long double)n / d);
+            }
+
+            /// \brief distance between 2 corners, 0 if both are infinite since the input doesn't separate them
+            static long double spread(const long double& u, const long double& v)
+            {
+                return (std::isinf(u) && std::isinf(v) ? 0 : std::abs(u - v));
+            }
+
+            /// \brief x = p + 1/x' (or y), infinity when the input is over
+            void ingest(bool from_x)
+            {
+                std::optional<T> p = (from_x ? x.term(x_index) : y.term(y_index));
+                std::array<T, 8> next;
+                for (int k = 0; k < 8; k += 4)
+                {
+                    T a = s[k], b = s[k + 1], c = s[k + 2], d = s[k + 3];
+                    if (from_x)
+                    {
+                        next[k] = (p ? checked_add(checked_mul(a, *p), c) : 0);
+                        next[k + 1] = (p ? checked_add(checked_mul(b, *p), d) : 0);
+                        next[k + 2] = a;
+                        next[k + 3] = b;
+                    }
+                    else
+                    {
+                        next[k] = (p ? checked_add(checked_mul(a, *p), b) : 0);
+                        next[k + 1] = a;
+                        next[k + 2] = (p ? checked_add(checked_mul(c, *p), d) : 0);
+                        next[k + 3] = c;
+                    }
+                }
+                s = next;
+                if (from_x)
+                {
+                    ++x_index;
+                    x_over = !p;
+                }
+                else
+                {
+                    ++y_index;
+                    y_over = !p;
+                }
+            }
+        };
+};
+
+/// \brief display the terms of a stream already computed, [a0; a1, a2, ...], with "..." unless the stream is known to end there
+/// \details no term is computed, so printing never throws nor changes the stream
+/// \tparam T : int
+/// \param cf : the stream we want to display
+template<typename T>
+std::ostream& operator<<(std::ostream& stream, const ContinuedFraction<T>& cf)
+{
+    const size_t n = cf.computed_terms();
+    std::vector<T> terms;
+    for (size_t i = 0; i < n; ++i)
+    {
+        terms.push_back(*cf.term(i));
+    }
+    stream << "[";
+    for (size_t i = 0; i < terms.size(); ++i)
+    {
+        stream << (i == 0 ? "" : (i == 1 ? "; " : ", ")) << terms[i];
+    }
+    if (!cf.is_finished())
+    {
+        stream << (terms.empty() ? "..." : (terms.size() == 1 ? "; ..." : ", ..."));
+    }
+    stream << "]";
+    return stream;
+}
+
+/// \brief return the closest Rational to ratio whose denominator is at most max_denominator
+/// \tparam T : int
+/// \param ratio : the Rational to approximate
+/// \param max_denominator : strictly positive bound
+template<typename T>
+Rational<T> limit_denominator(const Rational<T>& ratio, const T& max_denominator)
+{
+    if (ratio.get_denominator() <= max_denominator)
+    {
+        return ratio;
+    }
+    return ContinuedFraction<T>(ratio).best_approximation(max_denominator);
+}
+
+#endif
@@ -0,0 +1,564 @@
+#ifndef Farey_H
+#define Farey_H
+
+#include <cmath>
+#include <future>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Rational.h"
+
+/// \namespace farey_detail
+/// \brief fractions as (numerator, denominator) pairs, turned into Rational only when they are read
+namespace farey_detail
+{
+    /// \brief build a Rational from an already irreducible fraction with a positive denominator, without any gcd
+    template<typename T>
+    Rational<T> make(const T& p, const T& q)
+    {
+        Rational<T> ratio;
+        ratio.set_numerator(p);
+        ratio.set_denominator(q);
+        return ratio;
+    }
+
+    /// \brief a fraction that is not reduced yet as a Rational
+    template<typename T>
+    struct Fraction
+    {
+        T p; /**< numerator */
+        T q; /**< denominator */
+
+        /// \brief j * this + other, neighbors in the Stern-Brocot tree stay irreducible
+        Fraction combine(const T& j, const Fraction& other) const { return {j * p + other.p, j * q + other.q}; }
+    };
+}
+
+/// \class FareySequence
+/// \brief lazy Farey sequence of order N : every irreducible fraction of [0, 1] with a denominator <= N, in increasing order
+/// \details terms are generated by the next-term recurrence, so no gcd and no comparison is ever computed. The size is counted
+/// in O(N^(2/3)), the rank of a value in O(N log N) and the k-th term by a galloping Stern-Brocot descent on the ranks.
+/// Products of two values up to N (and N times the numerator of the values searched for) must fit in T
+/// \tparam T : int
+template<typename T = long long>
+class FareySequence
+{
+    public:
+        using Fraction = farey_detail::Fraction<T>;
+
+        /// \class iterator
+        /// \brief forward iterator on the terms, a/b followed by c/d
+        class iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Rational<T>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = Rational<T>;
+
+                iterator() = default;
+                iterator(const T& order, const Fraction& current, const Fraction& next, const size_t position)
+                    : m_order(order), m_current(current), m_next(next), m_position(position) {}
+
+                Rational<T> operator*() const { return farey_detail::make(m_current.p, m_current.q); }
+
+                /// \brief next term : k = (N + b) / d, (a/b, c/d) -> (c/d, (kc - a) / (kd - b))
+                iterator& operator++()
+                {
+                    T k = (m_order + m_current.q) / m_next.q;
+                    Fraction following = {k * m_next.p - m_current.p, k * m_next.q - m_current.q};
+                    m_current = m_next;
+                    m_next = following;
+                    ++m_position;
+                    return *this;
+                }
+
+                iterator operator++(int)
+                {
+                    iterator copy = *this;
+                    ++*this;
+                    return copy;
+                }
+
+                bool operator==(const iterator& other) const { return m_position == other.m_position; }
+                bool operator!=(const iterator& other) const { return m_position != other.m_position; }
+
+                /// \brief return the rank of the term pointed to
+                size_t position() const { return m_position; }
+
+            private:
+                T m_order = 1; /**< N */
+                Fraction m_current = {0, 1}; /**< term pointed to */
+                Fraction m_next = {1, 1}; /**< term after it */
+                size_t m_position = 0; /**< rank of the term in the sequence */
+        };
+
+        /// \class Range
+        /// \brief consecutive terms of the sequence, the unit of the chunked enumeration
+        class Range
+        {
+            public:
+                Range(const iterator& first, const size_t count) : m_first(first), m_count(count) {}
+
+                iterator begin() const { return m_first; }
+
+                /// \brief end iterators only compare positions, the terms past the range are never generated
+                iterator end() const { return iterator(1, Fraction{0, 1}, Fraction{1, 1}, m_first.position() + m_count); }
+
+                /// \brief return the number of terms
+                size_t size() const { return m_count; }
+
+                /// \brief return the rank of the first term in the whole sequence
+                size_t position() const { return m_first.position(); }
+
+            private:
+                iterator m_first; /**< first term */
+                size_t m_count; /**< number of terms */
+        };
+
+        //constructors
+
+        /// \brief sequence of order N
+        /// \tparam T : int
+        /// \param order : N >= 1
+        explicit FareySequence(const T& order) : m_order(order)
+        {
+            if (order < 1)
+            {
+                throw std::invalid_argument("order of a Farey sequence must be >= 1");
+            }
+            m_size = count(order);
+        }
+
+    private:
+        T m_order; /**< N */
+        size_t m_size; /**< number of terms */
+
+    public:
+        //Functions
+
+        /// \brief return N
+        T order() const { return m_order; }
+
+        /// \brief return the number of terms, 1 + phi(1) + ... + phi(N)
+        size_t size() const { return m_size; }
+
+        /// \brief iterator on 0/1
+        iterator begin() const { return iterator(m_order, Fraction{0, 1}, Fraction{1, m_order}, 0); }
+
+        /// \brief iterator past 1/1
+        iterator end() const { return iterator(m_order, Fraction{0, 1}, Fraction{1, 1}, m_size); }
+
+        /// \brief number of terms of the Farey sequence of order N, without generating them
+        /// \details sum of Euler's totient : Phi(n) = n(n + 1)/2 - sum_{d >= 2} Phi(n / d), with a sieve below N^(2/3)
+        static size_t count(const T& order)
+        {
+            size_t n = size_t(order);
+            size_t limit = std::max<size_t>(1, size_t(std::pow(double(n), 2.0 / 3.0)));
+            limit = std::min(limit, n);
+            std::vector<size_t> small(limit + 1);
+            for (size_t i = 0; i <= limit; ++i)
+            {
+                small[i] = i;
+            }
+            for (size_t i = 2; i <= limit; ++i)
+            {
+                if (small[i] == i)
+                {
+                    for (size_t j = i; j <= limit; j += i)
+                    {
+                        small[j] -= small[j] / i;
+                    }
+                }
+            }
+            small[0] = 0;
+            for (size_t i = 1; i <= limit; ++i)
+            {
+                small[i] += small[i - 1];
+            }
+            std::unordered_map<size_t, size_t> memo;
+            return 1 + totient_sum(n, small, memo);
+        }
+
+        /// \brief return the number of terms <= x
+        /// \param x : any value, terms are in [0, 1]
+        size_t rank(const Rational<T>& x) const
+        {
+            if (x < 0)
+            {
+                return 0;
+            }
+            if (x >= 1)
+            {
+                return m_size;
+            }
+            return rank(x.get_numerator(), x.get_denominator());
+        }
+
+        /// \brief return the term of rank k (0 is 0/1), throws std::invalid_argument if k >= size()
+        Rational<T> operator[](const size_t k) const
+        {
+            if (k >= m_size)
+            {
+                throw std::invalid_argument("rank out of the Farey sequence");
+            }
+            if (k == 0 || k == m_size - 1)
+            {
+                return farey_detail::make(T(k == 0 ? 0 : 1), T(1));
+            }
+            // the term is the node of the Stern-Brocot tree (restricted to [0, 1]) with rank(term) = k + 1, each run of moves
+            // in the same direction is found by a binary search on ranks, which are monotonic along the run
+            const size_t target = k + 1;
+            Fraction left = {0, 1};
+            Fraction right = {1, 1};
+            while (true)
+            {
+                Fraction middle = left.combine(1, right);
+                size_t middle_rank = rank(middle.p, middle.q);
+                if (middle_rank == target)
+                {
+                    return farey_detail::make(middle.p, middle.q);
+                }
+                const bool go_left = middle_rank > target;
+                // nodes j left + right (going left) or left + j right (going right), with a denominator <= N
+                T low = 1;
+                T high = (go_left ? (m_order - right.q) / left.q : (m_order - left.q) / right.q);
+                while (low < high)
+                {
+                    T j = low + (high - low + 1) / 2;
+                    Fraction node = (go_left ? left.combine(j, right) : right.combine(j, left));
+                    size_t node_rank = rank(node.p, node.q);
+                    if (go_left ? node_rank >= target : node_rank <= target)
+                    {
+                        low = j;
+                    }
+                    else
+                    {
+                        high = j - 1;
+                    }
+                }
+                Fraction node = (go_left ? left.combine(low, right) : right.combine(low, left));
+                if (rank(node.p, node.q) == target)
+                {
+                    return farey_detail::make(node.p, node.q);
+                }
+                (go_left ? right : left) = node;
+            }
+        }
+
+        /// \brief return the closest fractions with a denominator <= N strictly below and strictly above x
+        /// \details mediant descent of the Stern-Brocot tree, every run of moves in the same direction in one step.
+        /// x is not restricted to [0, 1]
+        /// \param x : value to bracket, numerator and denominator times N must fit in T
+        std::pair<Rational<T>, Rational<T>> neighbors(const Rational<T>& x) const
+        {
+            const T num = x.get_numerator();
+            const T den = x.get_denominator();
+            T integer = num / den;
+            if (num % den != 0 && num < 0)
+            {
+                --integer;
+            }
+            const T p = num - integer * den;
+            const T q = den;
+            const T n = m_order;
+            Fraction left = {0, 1};
+            Fraction right = {1, 1};
+            if (p == 0)
+            {
+                left = {n - 1, n};
+                right = {1, n};
+                return {farey_detail::make(left.p + (integer - 1) * left.q, left.q), farey_detail::make(right.p + integer * right.q, right.q)};
+            }
+            while (true)
+            {
+                Fraction middle = left.combine(1, right);
+                if (middle.q > n)
+                {
+                    break;
+                }
+                if (middle.p == p && middle.q == q)
+                {
+                    // x is a term : its neighbors are the furthest nodes of the subtrees hanging off its parents
+                    Fraction below = middle.combine((n - left.q) / middle.q, left);
+                    Fraction above = middle.combine((n - right.q) / middle.q, right);
+                    left = below;
+                    right = above;
+                    break;
+                }
+                if (p * middle.q < q * middle.p)
+                {
+                    // largest j with j left + right > x
+                    T j = (q * right.p - p * right.q - 1) / (p * left.q - q * left.p);
+                    j = std::min(j, (n - right.q) / left.q);
+                    right = left.combine(j, right);
+                }
+                else
+                {
+                    // largest j with left + j right < x
+                    T j = (p * left.q - q * left.p - 1) / (q * right.p - p * right.q);
+                    j = std::min(j, (n - left.q) / right.q);
+                    left = right.combine(j, left);
+                }
+            }
+            return {farey_detail::make(left.p + integer * left.q, left.q), farey_detail::make(right.p + integer * right.q, right.q)};
+        }
+
+        /// \brief split the sequence into consecutive ranges of (nearly) equal sizes
+        /// \details each range starts at a term found by rank and its successor, then runs the recurrence on its own
+        /// \param nb_chunks : number of ranges, >= 1
+        std::vector<Range> chunks(const size_t nb_chunks) const
+        {
+            if (nb_chunks == 0)
+            {
+                throw std::invalid_argument("number of chunks must be >= 1");
+            }
+            std::vector<Range> ranges;
+            for (size_t i = 0; i < nb_chunks; ++i)
+            {
+                size_t first = i * m_size / nb_chunks;
+                size_t last = (i + 1) * m_size / nb_chunks;
+                if (first == last)
+                {
+                    continue;
+                }
+                Rational<T> term = (*this)[first];
+                Rational<T> next = neighbors(term).second;
+                ranges.emplace_back(iterator(m_order, Fraction{term.get_numerator(), term.get_denominator()},
+                                             Fraction{next.get_numerator(), next.get_denominator()}, first), last - first);
+            }
+            return ranges;
+        }
+
+        /// \brief call func on every term, the chunks running in parallel
+        /// \tparam F : callable with a const Rational<T>&, called concurrently from several threads
+        /// \param func : function to call
+        /// \param nb_chunks : number of parallel chunks, 0 for the number of hardware threads
+        template<typename F>
+        void parallel_for_each(F func, size_t nb_chunks = 0) const
+        {
+            if (nb_chunks == 0)
+            {
+                nb_chunks = std::max(1u, std::thread::hardware_concurrency());
+            }
+            std::vector<std::future<void>> tasks;
+            for (const Range& range : chunks(nb_chunks))
+            {
+                tasks.push_back(std::async(std::launch::async, [range, &func]()
+                {
+                    for (const Rational<T>& term : range)
+                    {
+                        func(term);
+                    }
+                }));
+            }
+            for (std::future<void>& task : tasks)
+            {
+                task.get();
+            }
+        }
+
+    private:
+        /// \brief number of terms <= a/b for 0 <= a/b < 1
+        /// \details count[d] = floor(d a / b) counts every numerator over d, reduced ones are left once the counts of the
+        /// proper divisors of d are removed
+        size_t rank(const T& a, const T& b) const
+        {
+            const size_t n = size_t(m_order);
+            std::vector<T> counts(n + 1);
+            for (size_t d = 1; d <= n; ++d)
+            {
+                counts[d] = T(d) * a / b;
+            }
+            size_t total = 1;
+            for (size_t d = 1; d <= n; ++d)
+            {
+                for (size_t multiple = 2 * d; multiple <= n; multiple += d)
+                {
+                    counts[multiple] -= counts[d];
+                }
+                total += size_t(counts[d]);
+            }
+            return total;
+        }
+
+        /// \brief phi(1) + ... + phi(n)
+        static size_t totient_sum(const size_t n, const std::vector<size_t>& small, std::unordered_map<size_t, size_t>& memo)
+        {
+            if (n < small.size())
+            {
+                return small[n];
+            }
+            auto found = memo.find(n);
+            if (found != memo.end())
+            {
+                return found->second;
+            }
+            size_t result = n % 2 == 0 ? (n / 2) * (n + 1) : n * ((n + 1) / 2);
+            for (size_t d = 2; d <= n;)
+            {
+                size_t quotient = n / d;
+                size_t d_last = n / quotient;
+                result -= (d_last - d + 1) * totient_sum(quotient, small, memo);
+                d = d_last + 1;
+            }
+            memo[n] = result;
+            return result;
+        }
+};
+
+/// \class SternBrocotPath
+/// \brief lazy range of the nodes of the Stern-Brocot tree from the root 1/1 down to a positive rational x
+/// \details nodes are mediants of their two ancestors, so they are irreducible without any gcd
+/// \tparam T : int
+template<typename T = long long>
+class SternBrocotPath
+{
+    public:
+        using Fraction = farey_detail::Fraction<T>;
+
+        /// \class iterator
+        /// \brief forward iterator on the nodes
+        class iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = Rational<T>;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = Rational<T>;
+
+                iterator() = default;
+                iterator(const Fraction& target, const size_t position) : m_target(target), m_position(position) {}
+
+                Rational<T> operator*() const { return farey_detail::make(m_node.p, m_node.q); }
+
+                /// \brief move to the child on the side of x
+                iterator& operator++()
+                {
+                    if (m_target.p * m_node.q < m_target.q * m_node.p)
+                    {
+                        m_right = m_node;
+                    }
+                    else
+                    {
+                        m_left = m_node;
+                    }
+                    m_node = m_left.combine(1, m_right);
+                    ++m_position;
+                    return *this;
+                }
+
+                iterator operator++(int)
+                {
+                    iterator copy = *this;
+                    ++*this;
+                    return copy;
+                }
+
+                bool operator==(const iterator& other) const { return m_position == other.m_position; }
+                bool operator!=(const iterator& other) const { return m_position != other.m_position; }
+
+            private:
+                Fraction m_target = {1, 1}; /**< x */
+                Fraction m_left = {0, 1}; /**< left ancestor */
+                Fraction m_right = {1, 0}; /**< right ancestor (1/0 is infinity) */
+                Fraction m_node = {1, 1}; /**< current node */
+                size_t m_position = 0; /**< depth of the current node */
+        };
+
+        //constructors
+
+        /// \brief path to x
+        /// \tparam T : int
+        /// \param x : positive rational, throws std::invalid_argument otherwise
+        explicit SternBrocotPath(const Rational<T>& x) : m_target{x.get_numerator(), x.get_denominator()}
+        {
+            if (x <= 0)
+            {
+                throw std::invalid_argument("Stern-Brocot tree only holds positive rationals");
+            }
+            // run lengths are the continued fraction terms of x, the last one minus 1
+            T p = m_target.p;
+            T q = m_target.q;
+            bool right = true;
+            while (q != 0)
+            {
+                T a = p / q;
+                T r = p % q;
+                p = q;
+                q = r;
+                if (q == 0)
+                {
+                    --a;
+                }
+                if (a > 0)
+                {
+                    m_runs.emplace_back(right ? 'R' : 'L', a);
+                    m_depth += size_t(a);
+                }
+                right = !right;
+            }
+        }
+
+    private:
+        Fraction m_target; /**< x */
+        std::vector<std::pair<char, T>> m_runs; /**< run-length encoded path */
+        size_t m_depth = 0; /**< number of moves */
+
+    public:
+        //Functions
+
+        /// \brief iterator on the root 1/1
+        iterator begin() const { return iterator(m_target, 0); }
+
+        /// \brief iterator past x
+        iterator end() const { return iterator(m_target, m_depth + 1); }
+
+        /// \brief return the number of nodes, root and x included
+        size_t size() const { return m_depth + 1; }
+
+        /// \brief return the number of moves from the root to x
+        size_t depth() const { return m_depth; }
+
+        /// \brief return the path as runs of moves, ('R', 2), ('L', 2) for 7/3 ... ; empty for 1/1
+        const std::vector<std::pair<char, T>>& run_lengths() const { return m_runs; }
+
+        /// \brief return the path as a string of 'L' and 'R' moves
+        std::string to_string() const
+        {
+            std::string path;
+            for (const auto& run : m_runs)
+            {
+                path.append(size_t(run.second), run.first);
+            }
+            return path;
+        }
+
+        /// \brief return the node reached from the root by a path of 'L' and 'R' moves
+        /// \param path : moves, throws std::invalid_argument on any other character
+        static Rational<T> node(const std::string& path)
+        {
+            Fraction left = {0, 1};
+            Fraction right = {1, 0};
+            Fraction current = {1, 1};
+            for (const char move : path)
+            {
+                if (move != 'L' && move != 'R')
+                {
+                    throw std::invalid_argument("Stern-Brocot moves are 'L' and 'R'");
+                }
+                (move == 'L' ? right : left) = current;
+                current = left.combine(1, right);
+            }
+            return farey_detail::make(current.p, current.q);
+        }
+};
+
+#endif
@@ -0,0 +1,465 @@
+#ifndef Geometry_H
+#define Geometry_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "Rational.h"
+#include "WideInt.h"
+
+/// \namespace geometry_detail
+/// \brief floating point filter and exact evaluation shared by the predicates
+namespace geometry_detail
+{
+    /// \brief closest double of a Rational (up to 3 roundings : numerator, denominator and division)
+    template<typename T>
+    double to_double(const Rational<T>& ratio)
+    {
+        return double(ratio.get_numerator()) / double(ratio.get_denominator());
+    }
+
+    /// \brief return the sign of det if |det| is over the error bound, 0 if the filter can't decide (the exact path must run)
+    /// \details bounds are Shewchuk's first stage ones, multiplied to cover the error of the Rational to double conversion of the inputs,
+    /// the permanent uses |a| + |b| instead of |a - b| for the same reason
+    inline int filter(const double& det, const double& permanent, const double& factor)
+    {
+        constexpr double epsilon = std::numeric_limits<double>::epsilon() / 2;
+        if (!std::isfinite(det) || !std::isfinite(permanent))
+        {
+            return 0;
+        }
+        double bound = factor * epsilon * permanent;
+        return (det > bound ? 1 : (-det > bound ? -1 : 0));
+    }
+
+    /// \brief number of limbs for an exact determinant of degree `degree` in integers of `bits` bits, with some room for the sums
+    template<typename T>
+    constexpr size_t limbs(const size_t degree)
+    {
+        return (degree * (std::numeric_limits<T>::digits + 1) + 16) / 64 + 1;
+    }
+
+    using wide_detail::wide;
+    using wide_detail::gcd;
+
+    /// \brief irreducible Rational<R> n / d of exact integers, throws std::overflow_error if it doesn't fit in R
+    template<typename R, size_t N>
+    Rational<R> reduce(const WideInt<N>& n, const WideInt<N>& d)
+    {
+        WideInt<N> divisor = gcd(n, d);
+        divisor = (d.sign() < 0 ? -divisor : divisor);
+        long long numerator = (n / divisor).to_long_long(), denominator = (d / divisor).to_long_long();
+        if (numerator < (long long)(std::numeric_limits<R>::min()) || numerator > (long long)(std::numeric_limits<R>::max())
+            || denominator > (long long)(std::numeric_limits<R>::max()))
+        {
+            throw std::overflow_error("integer overflow");
+        }
+        Rational<R> ratio;
+        ratio.set_numerator(R(numerator));
+        ratio.set_denominator(R(denominator));
+        return ratio;
+    }
+
+    /// \brief 3x3 determinant
+    template<typename W>
+    W det3(const W& a, const W& b, const W& c, const W& d, const W& e, const W& f, const W& g, const W& h, const W& i)
+    {
+        return a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+    }
+
+    /// \brief 4x4 determinant (rows r0..r3)
+    template<typename W>
+    W det4(const std::array<std::array<W, 4>, 4>& m)
+    {
+        W result;
+        for (int col = 0; col < 4; ++col)
+        {
+            std::array<W, 9> minor;
+            int k = 0;
+            for (int i = 1; i < 4; ++i)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    if (j != col)
+                    {
+                        minor[k++] = m[i][j];
+                    }
+                }
+            }
+            W term = m[0][col] * det3(minor[0], minor[1], minor[2], minor[3], minor[4], minor[5], minor[6], minor[7], minor[8]);
+            result = (col % 2 == 0 ? result + term : result - term);
+        }
+        return result;
+    }
+
+    /// \brief n / d of exact integers (d > 0), what the Point operations compute before reducing to Rational<T>
+    template<size_t N>
+    struct Fraction
+    {
+        WideInt<N> n; /**< numerator */
+        WideInt<N> d; /**< denominator, positive */
+
+        Fraction operator+(const Fraction& other) const { return {n * other.d + other.n * d, d * other.d}; }
+        Fraction operator-(const Fraction& other) const { return {n * other.d - other.n * d, d * other.d}; }
+        Fraction operator*(const Fraction& other) const { return {n * other.n, d * other.d}; }
+    };
+
+    /// \brief exact Fraction of a Rational, room for the dot product of Point3 (3 products of 2 coordinates : degree 6)
+    template<typename T>
+    Fraction<limbs<T>(6)> fraction(const Rational<T>& ratio)
+    {
+        return {wide<limbs<T>(6)>(ratio.get_numerator()), wide<limbs<T>(6)>(ratio.get_denominator())};
+    }
+
+    /// \brief irreducible Rational<T> of an exact Fraction, throws std::overflow_error if it doesn't fit in T
+    template<typename T, size_t N>
+    Rational<T> exact(const Fraction<N>& value)
+    {
+        return reduce<T>(value.n, value.d);
+    }
+
+    /// \brief -1, 0 or 1 as a < b, a == b or a > b : the cross products are computed on WideInt, where they can't overflow
+    template<typename T>
+    int compare(const Rational<T>& a, const Rational<T>& b)
+    {
+        constexpr size_t L = limbs<T>(2);
+        return (wide<L>(a.get_numerator()) * wide<L>(b.get_denominator()) - wide<L>(b.get_numerator()) * wide<L>(a.get_denominator())).sign();
+    }
+}
+
+/// \struct Point2
+/// \brief point (or vector) of the plane with Rational coordinates
+/// \tparam T : int
+template<typename T = int>
+struct Point2
+{
+    Rational<T> x; /**< abscissa */
+    Rational<T> y; /**< ordinate */
+
+    /// \brief default constructor, the origin
+    Point2() = default;
+
+    /// \brief value constructor
+    /// \tparam U : int, floating point or Rational, floating point values go through convert_real_to_ratio
+    template<typename U, typename V>
+    Point2(const U& x_value, const V& y_value) : x(x_value), y(y_value) {}
+
+    /// \brief exact sum, throws std::overflow_error if a coordinate doesn't fit in T
+    Point2 operator+(const Point2& other) const
+    {
+        using namespace geometry_detail;
+        return Point2(exact<T>(fraction(x) + fraction(other.x)), exact<T>(fraction(y) + fraction(other.y)));
+    }
+
+    /// \brief exact difference, throws std::overflow_error if a coordinate doesn't fit in T
+    Point2 operator-(const Point2& other) const
+    {
+        using namespace geometry_detail;
+        return Point2(exact<T>(fraction(x) - fraction(other.x)), exact<T>(fraction(y) - fraction(other.y)));
+    }
+
+    /// \brief exact product by a scalar, throws std::overflow_error if a coordinate doesn't fit in T
+    Point2 operator*(const Rational<T>& scalar) const
+    {
+        using namespace geometry_detail;
+        return Point2(exact<T>(fraction(x) * fraction(scalar)), exact<T>(fraction(y) * fraction(scalar)));
+    }
+
+    bool operator==(const Point2& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const Point2& other) const { return !(*this == other); }
+};
+
+/// \struct Point3
+/// \brief point (or vector) of the space with Rational coordinates
+/// \tparam T : int
+template<typename T = int>
+struct Point3
+{
+    Rational<T> x; /**< first coordinate */
+    Rational<T> y; /**< second coordinate */
+    Rational<T> z; /**< third coordinate */
+
+    /// \brief default constructor, the origin
+    Point3() = default;
+
+    /// \brief value constructor
+    /// \tparam U : int, floating point or Rational, floating point values go through convert_real_to_ratio
+    template<typename U, typename V, typename W>
+    Point3(const U& x_value, const V& y_value, const W& z_value) : x(x_value), y(y_value), z(z_value) {}
+
+    /// \brief exact sum, throws std::overflow_error if a coordinate doesn't fit in T
+    Point3 operator+(const Point3& other) const
+    {
+        using namespace geometry_detail;
+        return Point3(exact<T>(fraction(x) + fraction(other.x)), exact<T>(fraction(y) + fraction(other.y)), exact<T>(fraction(z) + fraction(other.z)));
+    }
+
+    /// \brief exact difference, throws std::overflow_error if a coordinate doesn't fit in T
+    Point3 operator-(const Point3& other) const
+    {
+        using namespace geometry_detail;
+        return Point3(exact<T>(fraction(x) - fraction(other.x)), exact<T>(fraction(y) - fraction(other.y)), exact<T>(fraction(z) - fraction(other.z)));
+    }
+
+    /// \brief exact product by a scalar, throws std::overflow_error if a coordinate doesn't fit in T
+    Point3 operator*(const Rational<T>& scalar) const
+    {
+        using namespace geometry_detail;
+        return Point3(exact<T>(fraction(x) * fraction(scalar)), exact<T>(fraction(y) * fraction(scalar)), exact<T>(fraction(z) * fraction(scalar)));
+    }
+
+    bool operator==(const Point3& other) const { return x == other.x && y == other.y && z == other.z; }
+    bool operator!=(const Point3& other) const { return !(*this == other); }
+};
+
+/// \brief dot product of 2 vectors of the plane, exact, throws std::overflow_error if it doesn't fit in T
+template<typename T>
+Rational<T> dot(const Point2<T>& u, const Point2<T>& v)
+{
+    using namespace geometry_detail;
+    return exact<T>(fraction(u.x) * fraction(v.x) + fraction(u.y) * fraction(v.y));
+}
+
+/// \brief z coordinate of the cross product of 2 vectors of the plane, exact, throws std::overflow_error if it doesn't fit in T
+template<typename T>
+Rational<T> cross(const Point2<T>& u, const Point2<T>& v)
+{
+    using namespace geometry_detail;
+    return exact<T>(fraction(u.x) * fraction(v.y) - fraction(u.y) * fraction(v.x));
+}
+
+/// \brief dot product of 2 vectors of the space, exact, throws std::overflow_error if it doesn't fit in T
+template<typename T>
+Rational<T> dot(const Point3<T>& u, const Point3<T>& v)
+{
+    using namespace geometry_detail;
+    return exact<T>(fraction(u.x) * fraction(v.x) + fraction(u.y) * fraction(v.y) + fraction(u.z) * fraction(v.z));
+}
+
+/// \brief cross product of 2 vectors of the space, exact, throws std::overflow_error if a coordinate doesn't fit in T
+template<typename T>
+Point3<T> cross(const Point3<T>& u, const Point3<T>& v)
+{
+    using namespace geometry_detail;
+    auto minor = [](const Rational<T>& a, const Rational<T>& b, const Rational<T>& c, const Rational<T>& d)
+    {
+        return exact<T>(fraction(a) * fraction(b) - fraction(c) * fraction(d));
+    };
+    return Point3<T>(minor(u.y, v.z, u.z, v.y), minor(u.z, v.x, u.x, v.z), minor(u.x, v.y, u.y, v.x));
+}
+
+/// \brief orientation of 3 points of the plane : 1 if a, b, c turn counterclockwise, -1 if clockwise, 0 if they are collinear
+/// \details a floating point filter first, the exact evaluation only for the (nearly) degenerate cases
+/// \tparam T : int
+template<typename T>
+int orient2d(const Point2<T>& a, const Point2<T>& b, const Point2<T>& c)
+{
+    using namespace geometry_detail;
+    double ax = to_double(a.x), ay = to_double(a.y);
+    double bx = to_double(b.x), by = to_double(b.y);
+    double cx = to_double(c.x), cy = to_double(c.y);
+    double det = (ax - cx) * (by - cy) - (ay - cy) * (bx - cx);
+    double permanent = (std::abs(ax) + std::abs(cx)) * (std::abs(by) + std::abs(cy)) + (std::abs(ay) + std::abs(cy)) * (std::abs(bx) + std::abs(cx));
+    int sign = filter(det, permanent, 16);
+    return (sign != 0 ? sign : orient2d_exact(a, b, c));
+}
+
+/// \brief orient2d without the floating point filter
+/// \tparam T : int
+template<typename T>
+int orient2d_exact(const Point2<T>& a, const Point2<T>& b, const Point2<T>& c)
+{
+    using namespace geometry_detail;
+    // homogeneous integer coordinates (x_num y_den, y_num x_den, x_den y_den), the positive w don't change the sign
+    using W = WideInt<limbs<T>(6)>;
+    auto row = [](const Point2<T>& p) -> std::array<W, 3>
+    {
+        W xn = wide<limbs<T>(6)>(p.x.get_numerator()), xd = wide<limbs<T>(6)>(p.x.get_denominator());
+        W yn = wide<limbs<T>(6)>(p.y.get_numerator()), yd = wide<limbs<T>(6)>(p.y.get_denominator());
+        return {xn * yd, yn * xd, xd * yd};
+    };
+    std::array<W, 3> ra = row(a), rb = row(b), rc = row(c);
+    return det3(ra[0], ra[1], ra[2], rb[0], rb[1], rb[2], rc[0], rc[1], rc[2]).sign();
+}
+
+/// \brief orientation of 4 points of the space : 1 if d is below the plane of a, b, c (a, b, c counterclockwise seen from above),
+/// -1 if above, 0 if coplanar (same convention as Shewchuk's orient3d, the sign of det[a - d, b - d, c - d])
+/// \tparam T : int
+template<typename T>
+int orient3d(const Point3<T>& a, const Point3<T>& b, const Point3<T>& c, const Point3<T>& d)
+{
+    using namespace geometry_detail;
+    double dx = to_double(d.x), dy = to_double(d.y), dz = to_double(d.z);
+    double v[3][3], s[3][3];
+    const Point3<T>* points[3] = {&a, &b, &c};
+    for (int i = 0; i < 3; ++i)
+    {
+        double px = to_double(points[i]->x), py = to_double(points[i]->y), pz = to_double(points[i]->z);
+        v[i][0] = px - dx; v[i][1] = py - dy; v[i][2] = pz - dz;
+        s[i][0] = std::abs(px) + std::abs(dx); s[i][1] = std::abs(py) + std::abs(dy); s[i][2] = std::abs(pz) + std::abs(dz);
+    }
+    double det = det3(v[0][0], v[0][1], v[0][2], v[1][0], v[1][1], v[1][2], v[2][0], v[2][1], v[2][2]);
+    double permanent = s[0][0] * (s[1][1] * s[2][2] + s[1][2] * s[2][1])
+                     + s[0][1] * (s[1][0] * s[2][2] + s[1][2] * s[2][0])
+                     + s[0][2] * (s[1][0] * s[2][1] + s[1][1] * s[2][0]);
+    int sign = filter(det, permanent, 32);
+    return (sign != 0 ? sign : orient3d_exact(a, b, c, d));
+}
+
+/// \brief orient3d without the floating point filter
+/// \tparam T : int
+template<typename T>
+int orient3d_exact(const Point3<T>& a, const Point3<T>& b, const Point3<T>& c, const Point3<T>& d)
+{
+    using namespace geometry_detail;
+    // rows (X, Y, Z, W) in homogeneous integer coordinates, W > 0
+    constexpr size_t L = limbs<T>(12);
+    using W = WideInt<L>;
+    auto row = [](const Point3<T>& p) -> std::array<W, 4>
+    {
+        W xn = wide<L>(p.x.get_numerator()), xd = wide<L>(p.x.get_denominator());
+        W yn = wide<L>(p.y.get_numerator()), yd = wide<L>(p.y.get_denominator());
+        W zn = wide<L>(p.z.get_numerator()), zd = wide<L>(p.z.get_denominator());
+        return {xn * yd * zd, yn * xd * zd, zn * xd * yd, xd * yd * zd};
+    };
+    // det[a - d, b - d, c - d] = det[[a, 1], [b, 1], [c, 1], [d, 1]] (subtract the last row from the others)
+    std::array<std::array<W, 4>, 4> m = {row(a), row(b), row(c), row(d)};
+    return det4(m).sign();
+}
+
+/// \brief position of d relative to the circle through a, b, c (counterclockwise) : 1 inside, -1 outside, 0 on the circle
+/// \tparam T : int
+template<typename T>
+int incircle(const Point2<T>& a, const Point2<T>& b, const Point2<T>& c, const Point2<T>& d)
+{
+    using namespace geometry_detail;
+    double dx = to_double(d.x), dy = to_double(d.y);
+    double v[3][3], s[3][3];
+    const Point2<T>* points[3] = {&a, &b, &c};
+    for (int i = 0; i < 3; ++i)
+    {
+        double px = to_double(points[i]->x), py = to_double(points[i]->y);
+        v[i][0] = px - dx; v[i][1] = py - dy; v[i][2] = v[i][0] * v[i][0] + v[i][1] * v[i][1];
+        s[i][0] = std::abs(px) + std::abs(dx); s[i][1] = std::abs(py) + std::abs(dy); s[i][2] = s[i][0] * s[i][0] + s[i][1] * s[i][1];
+    }
+    double det = det3(v[0][0], v[0][1], v[0][2], v[1][0], v[1][1], v[1][2], v[2][0], v[2][1], v[2][2]);
+    double permanent = s[0][2] * (s[1][0] * s[2][1] + s[1][1] * s[2][0])
+                     + s[1][2] * (s[0][0] * s[2][1] + s[0][1] * s[2][0])
+                     + s[2][2] * (s[0][0] * s[1][1] + s[0][1] * s[1][0]);
+    int sign = filter(det, permanent, 64);
+    return (sign != 0 ? sign : incircle_exact(a, b, c, d));
+}
+
+/// \brief incircle without the floating point filter
+/// \tparam T : int
+template<typename T>
+int incircle_exact(const Point2<T>& a, const Point2<T>& b, const Point2<T>& c, const Point2<T>& d)
+{
+    using namespace geometry_detail;
+    // lifted rows (X W, Y W, X^2 + Y^2, W^2) = W^2 (x, y, x^2 + y^2, 1), W^2 > 0
+    constexpr size_t L = limbs<T>(16);
+    using W = WideInt<L>;
+    auto row = [](const Point2<T>& p) -> std::array<W, 4>
+    {
+        W xn = wide<L>(p.x.get_numerator()), xd = wide<L>(p.x.get_denominator());
+        W yn = wide<L>(p.y.get_numerator()), yd = wide<L>(p.y.get_denominator());
+        W X = xn * yd, Y = yn * xd, w = xd * yd;
+        return {X * w, Y * w, X * X + Y * Y, w * w};
+    };
+    // det[a - d, b - d, c - d] (lifted) = det[[a, 1], [b, 1], [c, 1], [d, 1]] (lifted), the lifted differences only differ
+    // from |a - d|^2 by a combination of the first two columns
+    std::array<std::array<W, 4>, 4> m = {row(a), row(b), row(c), row(d)};
+    return det4(m).sign();
+}
+
+/// \brief return true if the point p lies on the closed segment [a, b]
+/// \tparam T : int
+template<typename T>
+bool on_segment(const Point2<T>& p, const Point2<T>& a, const Point2<T>& b)
+{
+    using namespace geometry_detail;
+    // p is between a and b on each axis when it is on neither strict side of both
+    return orient2d(a, b, p) == 0
+        && compare(p.x, a.x) * compare(p.x, b.x) <= 0
+        && compare(p.y, a.y) * compare(p.y, b.y) <= 0;
+}
+
+/// \brief return true if the closed segments [p1, p2] and [q1, q2] have at least one common point (exact)
+/// \tparam T : int
+template<typename T>
+bool segments_intersect(const Point2<T>& p1, const Point2<T>& p2, const Point2<T>& q1, const Point2<T>& q2)
+{
+    int o1 = orient2d(p1, p2, q1);
+    int o2 = orient2d(p1, p2, q2);
+    int o3 = orient2d(q1, q2, p1);
+    int o4 = orient2d(q1, q2, p2);
+    if (o1 * o2 < 0 && o3 * o4 < 0)
+    {
+        return true;
+    }
+    return (o1 == 0 && on_segment(q1, p1, p2)) || (o2 == 0 && on_segment(q2, p1, p2))
+        || (o3 == 0 && on_segment(p1, q1, q2)) || (o4 == 0 && on_segment(p2, q1, q2));
+}
+
+/// \brief exact common point of the segments [p1, p2] and [q1, q2], std::nullopt if they don't intersect or overlap on more than a point
+/// \details the decision uses the exact predicates, the point is the cross product of the two lines (each one the cross product of
+/// its end points in homogeneous integer coordinates) computed on WideInt, then reduced to Rational<R> (long long by default).
+/// Throws std::overflow_error if the reduced coordinates don't fit in R
+/// \tparam R : int, type of the result
+/// \tparam T : int
+template<typename R = long long, typename T>
+std::optional<Point2<R>> intersection_point(const Point2<T>& p1, const Point2<T>& p2, const Point2<T>& q1, const Point2<T>& q2)
+{
+    using namespace geometry_detail;
+    if (!segments_intersect(p1, p2, q1, q2))
+    {
+        return std::nullopt;
+    }
+    // (x_num y_den, y_num x_den, x_den y_den) : 2 input integers per coordinate, 4 per line, 8 per intersection
+    constexpr size_t L = limbs<T>(8);
+    using W = WideInt<L>;
+    using Homogeneous = std::array<W, 3>;
+    auto homogeneous = [](const Point2<T>& p) -> Homogeneous
+    {
+        W xn = wide<L>(p.x.get_numerator()), xd = wide<L>(p.x.get_denominator());
+        W yn = wide<L>(p.y.get_numerator()), yd = wide<L>(p.y.get_denominator());
+        return {xn * yd, yn * xd, xd * yd};
+    };
+    auto cross3 = [](const Homogeneous& u, const Homogeneous& v) -> Homogeneous
+    {
+        return {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+    };
+    Homogeneous point = cross3(cross3(homogeneous(p1), homogeneous(p2)), cross3(homogeneous(q1), homogeneous(q2)));
+    if (point[2].sign() != 0)
+    {
+        return Point2<R>(reduce<R>(point[0], point[2]), reduce<R>(point[1], point[2]));
+    }
+
+    // collinear : the common part is bounded by end points, it is a single point only if they are all the same
+    std::optional<Point2<T>> common;
+    for (const auto& candidate : {std::make_pair(p1, on_segment(p1, q1, q2)), std::make_pair(p2, on_segment(p2, q1, q2)),
+                                  std::make_pair(q1, on_segment(q1, p1, p2)), std::make_pair(q2, on_segment(q2, p1, p2))})
+    {
+        if (candidate.second)
+        {
+            if (common && *common != candidate.first)
+            {
+                return std::nullopt;
+            }
+            common = candidate.first;
+        }
+    }
+    if (!common)
+    {
+        return std::nullopt;
+    }
+    auto widen = [](const Rational<T>& ratio) { return reduce<R>(wide<L>(ratio.get_numerator()), wide<L>(ratio.get_denominator())); };
+    return Point2<R>(widen(common->x), widen(common->y));
+}
+
+#endif
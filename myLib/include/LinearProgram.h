@@ -0,0 +1,737 @@
+#ifndef LinearProgram_H
+#define LinearProgram_H
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Rational.h"
+
+/// \namespace linear_program_detail
+/// \brief checked exact arithmetic of the certificate and the exact pivots
+namespace linear_program_detail
+{
+    using Wide = __int128;
+
+    /// \brief return a + b, throws std::overflow_error if it doesn't fit in Wide
+    inline Wide checked_add(const Wide& a, const Wide& b)
+    {
+        Wide result;
+        if (__builtin_add_overflow(a, b, &result))
+        {
+            throw std::overflow_error("integer overflow");
+        }
+        return result;
+    }
+
+    /// \class Checked
+    /// \brief a Rational<T> whose operations are computed on Wide and reduced : a result that doesn't fit in T throws
+    /// std::overflow_error instead of wrapping, so a certificate is never built on garbage
+    /// \tparam T : int or long long, the cross products of 2 values must fit in Wide
+    template<typename T>
+    class Checked
+    {
+        static_assert(std::numeric_limits<T>::digits <= 63, "the products of 2 values must fit in __int128");
+
+        public:
+            /// \brief default constructor with value of 0
+            Checked() = default;
+
+            /// \brief value constructor from a small integer (the 0, 1 and -1 of the simplex)
+            Checked(const int value) : m_value(T(value), T(1)) {}
+
+            /// \brief value constructor
+            explicit Checked(const Rational<T>& value) : m_value(value) {}
+
+        private:
+            Rational<T> m_value; /**< irreducible value */
+
+            /// \brief irreducible n / d, throws std::overflow_error if it doesn't fit in T
+            static Checked make(Wide n, Wide d)
+            {
+                if (d < 0)
+                {
+                    n = -n;
+                    d = -d;
+                }
+                unsigned __int128 a = (unsigned __int128)(n < 0 ? -n : n), b = (unsigned __int128)(d);
+                while (b != 0)
+                {
+                    unsigned __int128 r = a % b;
+                    a = b;
+                    b = r;
+                }
+                if (a > 1)
+                {
+                    n /= Wide(a);
+                    d /= Wide(a);
+                }
+                if (n < Wide(std::numeric_limits<T>::min()) || n > Wide(std::numeric_limits<T>::max()) || d > Wide(std::numeric_limits<T>::max()))
+                {
+                    throw std::overflow_error("exact simplex values don't fit in the type");
+                }
+                Checked result;
+                result.m_value.set_numerator(T(n));
+                result.m_value.set_denominator(T(d));
+                return result;
+            }
+
+            Wide n() const { return m_value.get_numerator(); }
+            Wide d() const { return m_value.get_denominator(); }
+
+        public:
+            /// \brief return the value
+            const Rational<T>& value() const { return m_value; }
+
+            /// \brief return the absolute value
+            Checked abs() const { return (n() < 0 ? -*this : *this); }
+
+            //Operators
+
+            Checked operator-() const { return make(-n(), d()); }
+            Checked operator+(const Checked& other) const { return make(checked_add(n() * other.d(), other.n() * d()), d() * other.d()); }
+            Checked operator-(const Checked& other) const { return make(checked_add(n() * other.d(), -(other.n() * d())), d() * other.d()); }
+            Checked operator*(const Checked& other) const { return make(n() * other.n(), d() * other.d()); }
+            Checked operator/(const Checked& other) const { return make(n() * other.d(), d() * other.n()); }
+
+            // denominators are positive, the cross products fit in Wide
+            bool operator==(const Checked& other) const { return n() == other.n() && d() == other.d(); }
+            bool operator<(const Checked& other) const { return n() * other.d() < other.n() * d(); }
+            bool operator>(const Checked& other) const { return other < *this; }
+            bool operator<=(const Checked& other) const { return !(other < *this); }
+            bool operator>=(const Checked& other) const { return !(*this < other); }
+    };
+}
+
+/// \struct LinearProgramSolution
+/// \brief result of LinearProgram::solve, exact values are certified : x is feasible, duals are feasible and c.x = b.y
+/// \tparam T : int
+template<typename T>
+struct LinearProgramSolution
+{
+    /// \brief outcome of the solver
+    enum Status
+    {
+        optimal,    /**< x and duals are optimal */
+        infeasible, /**< no x satisfies the constraints */
+        unbounded   /**< the objective can grow without bound */
+    };
+
+    Status status = infeasible; /**< outcome of the solver */
+    Rational<T> objective; /**< optimal value of the objective */
+    std::vector<Rational<T>> x; /**< optimal values of the variables */
+    std::vector<Rational<T>> duals; /**< optimal dual values, one per constraint in the order they were added */
+    size_t float_pivots = 0; /**< pivots done in floating point */
+    size_t exact_pivots = 0; /**< pivots done in exact arithmetic (0 when the floating point basis was certified directly) */
+};
+
+/// \class LinearProgram
+/// \brief maximize c.x subject to linear constraints and x >= 0, solved exactly over Rational<T>
+/// \details revised simplex on a sparse column storage. Pricing and ratio tests run on double approximations (Dantzig's rule,
+/// Bland's rule after a few degenerate pivots so it can't cycle, and a cap on the number of pivots). The final basis is then
+/// factorized exactly and certified (primal and dual feasibility) ; if the certificate fails, exact pivots (Bland's rule) repair
+/// it. Every exact operation is checked (linear_program_detail::Checked) : solve() throws std::overflow_error rather than
+/// returning a status built on values that don't fit in T.
+/// \tparam T : int or long long, long long is advised
+template<typename T = long long>
+class LinearProgram
+{
+    public:
+        /// \brief kind of a constraint
+        enum Constraint
+        {
+            less_equal,     /**< a.x <= b */
+            equal,          /**< a.x = b */
+            greater_equal   /**< a.x >= b */
+        };
+
+        /// \brief a sparse row : (variable index, coefficient)
+        using SparseRow = std::vector<std::pair<size_t, Rational<T>>>;
+
+        //constructors
+
+        /// \brief empty program with a 0 objective
+        /// \tparam T : int
+        /// \param nb_variables : number of variables, all of them are >= 0
+        explicit LinearProgram(const size_t nb_variables) : m_objective(nb_variables) {}
+
+    private:
+        std::vector<Rational<T>> m_objective; /**< c */
+        std::vector<SparseRow> m_rows; /**< constraints coefficients */
+        std::vector<Constraint> m_types; /**< constraints kinds */
+        std::vector<Rational<T>> m_rhs; /**< constraints right hand sides */
+
+    public:
+        //Functions
+
+        /// \brief return the number of variables
+        size_t nb_variables() const { return m_objective.size(); }
+
+        /// \brief return the number of constraints
+        size_t nb_constraints() const { return m_rows.size(); }
+
+        /// \brief set the objective to maximize
+        /// \param objective : one coefficient per variable
+        void set_objective(const std::vector<Rational<T>>& objective)
+        {
+            if (objective.size() != nb_variables())
+            {
+                throw std::invalid_argument("objective must have one coefficient per variable");
+            }
+            m_objective = objective;
+        }
+
+        /// \brief add a sparse constraint
+        /// \param row : (variable index, coefficient) pairs
+        /// \param type : kind of constraint
+        /// \param rhs : right hand side
+        void add_constraint(const SparseRow& row, const Constraint type, const Rational<T>& rhs)
+        {
+            for (const auto& entry : row)
+            {
+                if (entry.first >= nb_variables())
+                {
+                    throw std::invalid_argument("variable index out of range");
+                }
+            }
+            m_rows.push_back(row);
+            m_types.push_back(type);
+            m_rhs.push_back(rhs);
+        }
+
+        /// \brief add a dense constraint
+        /// \param row : one coefficient per variable
+        /// \param type : kind of constraint
+        /// \param rhs : right hand side
+        void add_constraint(const std::vector<Rational<T>>& row, const Constraint type, const Rational<T>& rhs)
+        {
+            if (row.size() != nb_variables())
+            {
+                throw std::invalid_argument("constraint must have one coefficient per variable");
+            }
+            SparseRow sparse;
+            for (size_t j = 0; j < row.size(); ++j)
+            {
+                if (row[j] != 0)
+                {
+                    sparse.emplace_back(j, row[j]);
+                }
+            }
+            add_constraint(sparse, type, rhs);
+        }
+
+        /// \brief solve the program, throws std::overflow_error if an exact pivot or the certificate doesn't fit in T
+        /// \param float_guided : if false, every pivot is done in exact arithmetic (slower, used as a reference)
+        LinearProgramSolution<T> solve(const bool float_guided = true) const
+        {
+            StandardForm form(*this);
+            LinearProgramSolution<T> solution;
+            std::vector<size_t> basis = form.initial_basis();
+
+            if (float_guided)
+            {
+                Simplex<double> approximate(form, form.columns_double, form.rhs_double, 1e-9);
+                if (approximate.start(basis))
+                {
+                    typename Simplex<double>::Result result = approximate.run_two_phases();
+                    solution.float_pivots = approximate.pivots;
+                    if (result == Simplex<double>::optimal)
+                    {
+                        std::optional<LinearProgramSolution<T>> certified = form.certify(approximate.basis, solution);
+                        if (certified)
+                        {
+                            return *certified;
+                        }
+                        // repair : exact pivots from the floating point basis if it is at least exactly feasible, phase 1 first
+                        // if an artificial is still positive (the floating point phase 1 took a tiny infeasibility for 0)
+                        Simplex<Exact> exact(form, form.columns, form.rhs, Exact());
+                        if (exact.start(approximate.basis) && exact.is_feasible())
+                        {
+                            if (!exact.artificials_are_zero())
+                            {
+                                return form.finish(exact, exact.run_two_phases(), solution);
+                            }
+                            exact.phase = 2;
+                            return form.finish(exact, exact.run(), solution);
+                        }
+                    }
+                }
+            }
+
+            // exact from scratch (also certifies infeasible and unbounded answers, and takes over from a stalled float run)
+            Simplex<Exact> exact(form, form.columns, form.rhs, Exact());
+            exact.start(basis);
+            return form.finish(exact, exact.run_two_phases(), solution);
+        }
+
+    private:
+        using Exact = linear_program_detail::Checked<T>; /**< the number type of the exact pivots and the certificate */
+
+        struct StandardForm;
+
+        /// \struct Simplex
+        /// \brief revised simplex with an explicit dense basis inverse, on double (with a tolerance) or Exact (tolerance 0)
+        template<typename Number>
+        struct Simplex
+        {
+            enum Result { optimal, infeasible, unbounded, stalled };
+
+            const StandardForm& form; /**< the program */
+            const std::vector<std::vector<std::pair<size_t, Number>>>& columns; /**< sparse columns */
+            const std::vector<Number>& rhs; /**< b */
+            Number tolerance; /**< a value is taken as 0 when its magnitude is under the tolerance */
+            int phase = 1; /**< 1 : maximize -sum(artificials), 2 : maximize c.x */
+            std::vector<size_t> basis; /**< basic column of each row */
+            std::vector<bool> is_basic; /**< true for basic columns */
+            std::vector<std::vector<Number>> B_inverse; /**< dense inverse of the basis */
+            std::vector<Number> x_B; /**< values of the basic variables */
+            size_t pivots = 0; /**< number of pivots done */
+            size_t degenerate_pivots = 0; /**< consecutive pivots that didn't move */
+
+            size_t max_pivots; /**< run() stops with `stalled` after this many pivots, only the double simplex has a cap */
+
+            static constexpr size_t bland_after = 8; /**< consecutive degenerate pivots before switching to Bland's rule */
+            static constexpr size_t pivots_per_column = 50; /**< cap of the double simplex, per column of the program */
+
+            Simplex(const StandardForm& f, const std::vector<std::vector<std::pair<size_t, Number>>>& c, const std::vector<Number>& b, const Number& tol)
+                : form(f), columns(c), rhs(b), tolerance(tol),
+                  max_pivots(std::is_same_v<Number, double> ? pivots_per_column * (f.nb_columns + f.m) : std::numeric_limits<size_t>::max()) {}
+
+            bool is_zero(const Number& value) const { return value <= tolerance && -value <= tolerance; }
+            bool is_positive(const Number& value) const { return value > tolerance; }
+
+            Number cost(const size_t j) const
+            {
+                if (phase == 1)
+                {
+                    return Number(j >= form.first_artificial ? -1 : 0);
+                }
+                return (j >= form.first_artificial ? Number(0) : to_number(form.cost[j]));
+            }
+
+            static Number to_number(const Exact& value)
+            {
+                if constexpr (std::is_same_v<Number, double>)
+                {
+                    return StandardForm::to_double(value.value());
+                }
+                else
+                {
+                    return value;
+                }
+            }
+
+            /// \brief factorize a basis (Gauss-Jordan with partial pivoting), false if it is singular
+            bool start(const std::vector<size_t>& start_basis)
+            {
+                const size_t m = form.m;
+                basis = start_basis;
+                is_basic.assign(form.nb_columns, false);
+                std::vector<std::vector<Number>> B(m, std::vector<Number>(m, Number(0)));
+                B_inverse.assign(m, std::vector<Number>(m, Number(0)));
+                for (size_t k = 0; k < m; ++k)
+                {
+                    is_basic[basis[k]] = true;
+                    for (const auto& entry : columns[basis[k]])
+                    {
+                        B[entry.first][k] = entry.second;
+                    }
+                    B_inverse[k][k] = Number(1);
+                }
+                for (size_t col = 0; col < m; ++col)
+                {
+                    size_t pivot = col;
+                    for (size_t i = col + 1; i < m; ++i)
+                    {
+                        if (magnitude(B[i][col]) > magnitude(B[pivot][col]))
+                        {
+                            pivot = i;
+                        }
+                    }
+                    if (is_zero(B[pivot][col]))
+                    {
+                        return false;
+                    }
+                    std::swap(B[pivot], B[col]);
+                    std::swap(B_inverse[pivot], B_inverse[col]);
+                    Number inverse = Number(1) / B[col][col];
+                    for (size_t j = 0; j < m; ++j)
+                    {
+                        B[col][j] = B[col][j] * inverse;
+                        B_inverse[col][j] = B_inverse[col][j] * inverse;
+                    }
+                    for (size_t i = 0; i < m; ++i)
+                    {
+                        if (i != col && !(B[i][col] == Number(0)))
+                        {
+                            Number factor = B[i][col];
+                            for (size_t j = 0; j < m; ++j)
+                            {
+                                B[i][j] = B[i][j] - factor * B[col][j];
+                                B_inverse[i][j] = B_inverse[i][j] - factor * B_inverse[col][j];
+                            }
+                        }
+                    }
+                }
+                x_B.assign(m, Number(0));
+                for (size_t i = 0; i < m; ++i)
+                {
+                    for (size_t k = 0; k < m; ++k)
+                    {
+                        x_B[i] = x_B[i] + B_inverse[i][k] * rhs[k];
+                    }
+                }
+                return true;
+            }
+
+            static Number magnitude(const Number& value)
+            {
+                if constexpr (std::is_same_v<Number, double>)
+                {
+                    return std::abs(value);
+                }
+                else
+                {
+                    return value.abs();
+                }
+            }
+
+            /// \brief true if every basic variable is >= 0
+            bool is_feasible() const
+            {
+                for (const Number& value : x_B)
+                {
+                    if (value < -tolerance)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /// \brief true if every basic artificial variable is 0, the basic solution then satisfies the original constraints
+            bool artificials_are_zero() const
+            {
+                for (size_t i = 0; i < form.m; ++i)
+                {
+                    if (basis[i] >= form.first_artificial && !is_zero(x_B[i]))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /// \brief y = c_B B^-1
+            std::vector<Number> simplex_multipliers() const
+            {
+                const size_t m = form.m;
+                std::vector<Number> y(m, Number(0));
+                for (size_t i = 0; i < m; ++i)
+                {
+                    Number c = cost(basis[i]);
+                    if (!(c == Number(0)))
+                    {
+                        for (size_t k = 0; k < m; ++k)
+                        {
+                            y[k] = y[k] + c * B_inverse[i][k];
+                        }
+                    }
+                }
+                return y;
+            }
+
+            /// \brief pricing : a column with a positive reduced cost, Dantzig's rule (largest) or Bland's rule (smallest index)
+            std::optional<size_t> entering_variable() const
+            {
+                std::vector<Number> y = simplex_multipliers();
+                const bool bland = (degenerate_pivots >= bland_after || std::is_same_v<Number, Exact>);
+                std::optional<size_t> best;
+                Number best_cost = Number(0);
+                // artificial columns never enter in phase 2
+                size_t end = (phase == 1 ? form.nb_columns : form.first_artificial);
+                for (size_t j = 0; j < end; ++j)
+                {
+                    if (is_basic[j])
+                    {
+                        continue;
+                    }
+                    Number reduced = cost(j);
+                    for (const auto& entry : columns[j])
+                    {
+                        reduced = reduced - y[entry.first] * entry.second;
+                    }
+                    if (is_positive(reduced) && (!best || reduced > best_cost))
+                    {
+                        best = j;
+                        best_cost = reduced;
+                        if (bland)
+                        {
+                            break;
+                        }
+                    }
+                }
+                return best;
+            }
+
+            /// \brief run until optimal or unbounded, or stalled once max_pivots is reached
+            Result run()
+            {
+                while (true)
+                {
+                    if (pivots >= max_pivots)
+                    {
+                        return stalled;
+                    }
+                    std::optional<size_t> entering = entering_variable();
+                    if (!entering)
+                    {
+                        return optimal;
+                    }
+                    const size_t m = form.m;
+                    std::vector<Number> u(m, Number(0));
+                    for (size_t i = 0; i < m; ++i)
+                    {
+                        for (const auto& entry : columns[*entering])
+                        {
+                            u[i] = u[i] + B_inverse[i][entry.first] * entry.second;
+                        }
+                    }
+                    // ratio test, ties broken by the smallest basic index (Bland) ; in phase 2 a basic artificial at 0 leaves first
+                    std::optional<size_t> leaving;
+                    Number best_ratio = Number(0);
+                    for (size_t i = 0; i < m; ++i)
+                    {
+                        bool artificial = (phase == 2 && basis[i] >= form.first_artificial);
+                        if (artificial && !is_zero(u[i]))
+                        {
+                            if (!leaving || !(best_ratio == Number(0)) || basis[i] < basis[*leaving])
+                            {
+                                leaving = i;
+                                best_ratio = Number(0);
+                            }
+                            continue;
+                        }
+                        if (!is_positive(u[i]))
+                        {
+                            continue;
+                        }
+                        Number ratio = (x_B[i] < Number(0) ? Number(0) : x_B[i] / u[i]);
+                        if (!leaving || ratio < best_ratio || (!(best_ratio < ratio) && basis[i] < basis[*leaving]))
+                        {
+                            leaving = i;
+                            best_ratio = ratio;
+                        }
+                    }
+                    if (!leaving)
+                    {
+                        return unbounded;
+                    }
+                    pivot(*leaving, *entering, u);
+                    degenerate_pivots = (is_zero(best_ratio) ? degenerate_pivots + 1 : 0);
+                }
+            }
+
+            /// \brief phase 1 (maximize -sum(artificials)) then phase 2
+            Result run_two_phases()
+            {
+                phase = 1;
+                if (run() == stalled)
+                {
+                    return stalled;
+                }
+                Number infeasibility = Number(0);
+                for (size_t i = 0; i < form.m; ++i)
+                {
+                    if (basis[i] >= form.first_artificial)
+                    {
+                        infeasibility = infeasibility + x_B[i];
+                    }
+                }
+                if (is_positive(infeasibility))
+                {
+                    return infeasible;
+                }
+                phase = 2;
+                degenerate_pivots = 0;
+                return run();
+            }
+
+            /// \brief replace the basic variable of row r by the column q, u = B^-1 A_q
+            void pivot(const size_t r, const size_t q, const std::vector<Number>& u)
+            {
+                const size_t m = form.m;
+                Number inverse = Number(1) / u[r];
+                for (size_t k = 0; k < m; ++k)
+                {
+                    B_inverse[r][k] = B_inverse[r][k] * inverse;
+                }
+                x_B[r] = x_B[r] * inverse;
+                for (size_t i = 0; i < m; ++i)
+                {
+                    if (i != r && !(u[i] == Number(0)))
+                    {
+                        for (size_t k = 0; k < m; ++k)
+                        {
+                            B_inverse[i][k] = B_inverse[i][k] - u[i] * B_inverse[r][k];
+                        }
+                        x_B[i] = x_B[i] - u[i] * x_B[r];
+                    }
+                }
+                is_basic[basis[r]] = false;
+                is_basic[q] = true;
+                basis[r] = q;
+                ++pivots;
+            }
+        };
+
+        /// \struct StandardForm
+        /// \brief A x = b, b >= 0, x >= 0 with slack, surplus and artificial columns, stored by sparse columns
+        struct StandardForm
+        {
+            size_t m = 0; /**< number of rows */
+            size_t n = 0; /**< number of original variables */
+            size_t nb_columns = 0; /**< original + slack + artificial */
+            size_t first_artificial = 0; /**< columns from this index are artificial */
+            std::vector<std::vector<std::pair<size_t, Exact>>> columns; /**< exact sparse columns */
+            std::vector<std::vector<std::pair<size_t, double>>> columns_double; /**< approximate sparse columns */
+            std::vector<Exact> rhs; /**< b >= 0 */
+            std::vector<double> rhs_double; /**< approximate b */
+            std::vector<Exact> cost; /**< phase 2 costs */
+            std::vector<bool> negated; /**< rows multiplied by -1 to make b >= 0 */
+            std::vector<size_t> start_basis; /**< slack or artificial column of each row */
+
+            explicit StandardForm(const LinearProgram& program) : m(program.nb_constraints()), n(program.nb_variables())
+            {
+                columns.resize(n);
+                for (const Rational<T>& c : program.m_objective)
+                {
+                    cost.emplace_back(c);
+                }
+                negated.resize(m);
+                start_basis.resize(m);
+                std::vector<Constraint> types = program.m_types;
+                for (size_t i = 0; i < m; ++i)
+                {
+                    const Exact b(program.m_rhs[i]);
+                    negated[i] = (b < 0);
+                    rhs.push_back(negated[i] ? -b : b);
+                    if (negated[i] && types[i] != equal)
+                    {
+                        types[i] = (types[i] == less_equal ? greater_equal : less_equal);
+                    }
+                    for (const auto& entry : program.m_rows[i])
+                    {
+                        const Exact a(entry.second);
+                        columns[entry.first].emplace_back(i, negated[i] ? -a : a);
+                    }
+                }
+                // slack (+1) for <=, surplus (-1) for >=
+                for (size_t i = 0; i < m; ++i)
+                {
+                    if (types[i] != equal)
+                    {
+                        columns.push_back({{i, Exact(types[i] == less_equal ? 1 : -1)}});
+                        if (types[i] == less_equal)
+                        {
+                            start_basis[i] = columns.size() - 1;
+                        }
+                    }
+                }
+                first_artificial = columns.size();
+                for (size_t i = 0; i < m; ++i)
+                {
+                    if (types[i] != less_equal)
+                    {
+                        columns.push_back({{i, Exact(1)}});
+                        start_basis[i] = columns.size() - 1;
+                    }
+                }
+                nb_columns = columns.size();
+                cost.resize(nb_columns);
+
+                for (const auto& column : columns)
+                {
+                    columns_double.emplace_back();
+                    for (const auto& entry : column)
+                    {
+                        columns_double.back().emplace_back(entry.first, to_double(entry.second.value()));
+                    }
+                }
+                for (const Exact& b : rhs)
+                {
+                    rhs_double.push_back(to_double(b.value()));
+                }
+            }
+
+            std::vector<size_t> initial_basis() const { return start_basis; }
+
+            /// \brief exact check of a basis : returns the certified solution, std::nullopt if it isn't optimal
+            /// (or not even feasible : a basic artificial variable that isn't exactly 0)
+            std::optional<LinearProgramSolution<T>> certify(const std::vector<size_t>& basis, const LinearProgramSolution<T>& stats) const
+            {
+                Simplex<Exact> exact(*this, columns, rhs, Exact());
+                if (!exact.start(basis) || !exact.is_feasible() || !exact.artificials_are_zero())
+                {
+                    return std::nullopt;
+                }
+                exact.phase = 2;
+                if (exact.entering_variable())
+                {
+                    return std::nullopt;
+                }
+                return finish(exact, Simplex<Exact>::optimal, stats);
+            }
+
+            /// \brief build the solution from a finished exact simplex
+            LinearProgramSolution<T> finish(const Simplex<Exact>& exact, typename Simplex<Exact>::Result result, const LinearProgramSolution<T>& stats) const
+            {
+                LinearProgramSolution<T> solution = stats;
+                solution.exact_pivots = exact.pivots;
+                if (result == Simplex<Exact>::infeasible)
+                {
+                    solution.status = LinearProgramSolution<T>::infeasible;
+                    return solution;
+                }
+                if (result == Simplex<Exact>::unbounded)
+                {
+                    solution.status = LinearProgramSolution<T>::unbounded;
+                    return solution;
+                }
+                solution.status = LinearProgramSolution<T>::optimal;
+                std::vector<Exact> x(n);
+                for (size_t i = 0; i < m; ++i)
+                {
+                    if (exact.basis[i] < n)
+                    {
+                        x[exact.basis[i]] = exact.x_B[i];
+                    }
+                }
+                Exact objective;
+                for (size_t j = 0; j < n; ++j)
+                {
+                    objective = objective + cost[j] * x[j];
+                    solution.x.push_back(x[j].value());
+                }
+                solution.objective = objective.value();
+                std::vector<Exact> y = exact.simplex_multipliers();
+                solution.duals.resize(m);
+                for (size_t i = 0; i < m; ++i)
+                {
+                    solution.duals[i] = (negated[i] ? -y[i] : y[i]).value();
+                }
+                return solution;
+            }
+
+            static double to_double(const Rational<T>& ratio)
+            {
+                return double(ratio.get_numerator()) / double(ratio.get_denominator());
+            }
+        };
+};
+
+#endif
@@ -0,0 +1,568 @@
+#ifndef MultiModular_H
+#define MultiModular_H
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "Rational.h"
+
+/// \class MontgomeryField
+/// \brief arithmetic modulo an odd prime p < 2^63, multiplications in Montgomery form (R = 2^64) so there is no division
+class MontgomeryField
+{
+    public:
+        /// \brief field of the integers modulo p
+        /// \param modulus : odd prime lower than 2^63
+        explicit MontgomeryField(const uint64_t& modulus) : m_modulus(modulus)
+        {
+            if (modulus % 2 == 0 || modulus >= (uint64_t(1) << 63))
+            {
+                throw std::invalid_argument("modulus must be odd and lower than 2^63");
+            }
+            // Newton iteration, each step doubles the number of correct bits of p^-1 mod 2^64
+            uint64_t inverse = modulus;
+            for (int i = 0; i < 5; ++i)
+            {
+                inverse *= 2 - modulus * inverse;
+            }
+            m_inverse = 0 - inverse;
+            uint64_t r = uint64_t(((unsigned __int128)(1) << 64) % modulus);
+            m_r2 = uint64_t((unsigned __int128)(r) * r % modulus);
+        }
+
+    private:
+        uint64_t m_modulus; /**< the prime p */
+        uint64_t m_inverse; /**< -p^-1 mod 2^64 */
+        uint64_t m_r2; /**< 2^128 mod p */
+
+        /// \brief Montgomery reduction, return t / 2^64 mod p for t < p 2^64
+        uint64_t reduce(const unsigned __int128& t) const
+        {
+            uint64_t m = uint64_t(t) * m_inverse;
+            uint64_t result = uint64_t((t + (unsigned __int128)(m) * m_modulus) >> 64);
+            return (result >= m_modulus ? result - m_modulus : result);
+        }
+
+    public:
+        //Functions
+
+        /// \brief return the prime p
+        uint64_t modulus() const { return m_modulus; }
+
+        /// \brief return the Montgomery form a 2^64 mod p of a residue a
+        uint64_t to_montgomery(const uint64_t& a) const { return reduce((unsigned __int128)(a % m_modulus) * m_r2); }
+
+        /// \brief return the residue a mod p of a Montgomery form
+        uint64_t from_montgomery(const uint64_t& a) const { return reduce(a); }
+
+        /// \brief return the Montgomery form of a signed integer
+        uint64_t from_integer(const long long& a) const
+        {
+            uint64_t magnitude = (a < 0 ? 0 - uint64_t(a) : uint64_t(a)) % m_modulus;
+            return to_montgomery(a < 0 && magnitude != 0 ? m_modulus - magnitude : magnitude);
+        }
+
+        /// \brief sum of 2 Montgomery forms
+        uint64_t add(const uint64_t& a, const uint64_t& b) const
+        {
+            uint64_t sum = a + b;
+            return (sum >= m_modulus ? sum - m_modulus : sum);
+        }
+
+        /// \brief subtraction of 2 Montgomery forms
+        uint64_t sub(const uint64_t& a, const uint64_t& b) const
+        {
+            return (a >= b ? a - b : a + m_modulus - b);
+        }
+
+        /// \brief multiplication of 2 Montgomery forms
+        uint64_t mul(const uint64_t& a, const uint64_t& b) const
+        {
+            return reduce((unsigned __int128)(a) * b);
+        }
+
+        /// \brief power of a Montgomery form by square and multiply
+        uint64_t pow(uint64_t a, uint64_t n) const
+        {
+            uint64_t result = to_montgomery(1);
+            for (; n != 0; n >>= 1)
+            {
+                if (n & 1)
+                {
+                    result = mul(result, a);
+                }
+                a = mul(a, a);
+            }
+            return result;
+        }
+
+        /// \brief inverse of a Montgomery form (Fermat's little theorem), a can't be 0
+        uint64_t inverse(const uint64_t& a) const
+        {
+            if (a == 0)
+            {
+                throw std::invalid_argument("0 has no inverse");
+            }
+            return pow(a, m_modulus - 2);
+        }
+
+        /// \brief return the Montgomery form of a Rational, std::nullopt if its denominator is a multiple of p
+        /// \tparam T : int
+        /// \param ratio : the Rational
+        template<typename T>
+        std::optional<uint64_t> from_rational(const Rational<T>& ratio) const
+        {
+            uint64_t denominator = from_integer(ratio.get_denominator());
+            if (denominator == 0)
+            {
+                return std::nullopt;
+            }
+            return mul(from_integer(ratio.get_numerator()), inverse(denominator));
+        }
+
+        /// \brief deterministic Miller-Rabin test, exact for every 64-bit integer
+        static bool is_prime(const uint64_t& n)
+        {
+            if (n < 2)
+            {
+                return false;
+            }
+            for (uint64_t p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37})
+            {
+                if (n % p == 0)
+                {
+                    return n == p;
+                }
+            }
+            uint64_t d = n - 1;
+            int s = 0;
+            for (; d % 2 == 0; d /= 2)
+            {
+                ++s;
+            }
+            auto mulmod = [n](uint64_t a, uint64_t b) { return uint64_t((unsigned __int128)(a) * b % n); };
+            for (uint64_t a : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37})
+            {
+                uint64_t x = 1;
+                for (uint64_t base = a, e = d; e != 0; e >>= 1)
+                {
+                    if (e & 1)
+                    {
+                        x = mulmod(x, base);
+                    }
+                    base = mulmod(base, base);
+                }
+                if (x == 1 || x == n - 1)
+                {
+                    continue;
+                }
+                bool composite = true;
+                for (int i = 1; i < s && composite; ++i)
+                {
+                    x = mulmod(x, x);
+                    composite = (x != n - 1);
+                }
+                if (composite)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// \brief return the n largest primes lower than 2^63, in decreasing order
+        /// \param n : number of primes
+        static std::vector<uint64_t> largest_primes(const size_t n)
+        {
+            // the first ones are computed once, they cover every usual number of primes
+            static const std::vector<uint64_t> cached = search_primes(32);
+            if (n <= cached.size())
+            {
+                return std::vector<uint64_t>(cached.begin(), cached.begin() + n);
+            }
+            return search_primes(n);
+        }
+
+    private:
+        static std::vector<uint64_t> search_primes(const size_t n)
+        {
+            std::vector<uint64_t> primes;
+            for (uint64_t candidate = (uint64_t(1) << 63) - 1; primes.size() < n; candidate -= 2)
+            {
+                if (is_prime(candidate))
+                {
+                    primes.push_back(candidate);
+                }
+            }
+            return primes;
+        }
+};
+
+/// \brief Chinese remainder theorem on 2 residues, return x mod p1 p2 with x = r1 mod p1 and x = r2 mod p2
+/// \param r1 : residue modulo p1
+/// \param p1 : first prime
+/// \param r2 : residue modulo p2
+/// \param p2 : second prime
+inline unsigned __int128 crt_combine(const uint64_t& r1, const uint64_t& p1, const uint64_t& r2, const uint64_t& p2)
+{
+    // x = r1 + p1 * ((r2 - r1) * p1^-1 mod p2)
+    MontgomeryField field(p2);
+    uint64_t difference = field.sub(field.to_montgomery(r2), field.to_montgomery(r1));
+    uint64_t k = field.from_montgomery(field.mul(difference, field.inverse(field.to_montgomery(p1))));
+    return r1 + (unsigned __int128)(p1) * k;
+}
+
+/// \brief Wang's rational reconstruction, return n/d with n = u d mod m and |n|, d <= sqrt(m/2), std::nullopt if there is none
+/// \tparam T : int, the type of the result, std::nullopt if it doesn't fit
+/// \param u : residue modulo m
+/// \param m : modulus, lower than 2^127
+template<typename T>
+std::optional<Rational<T>> rational_reconstruction(const unsigned __int128& u, const unsigned __int128& m)
+{
+    // bound = floor(sqrt(m / 2))
+    unsigned __int128 half = m / 2;
+    unsigned __int128 bound = (unsigned __int128)(std::sqrt((long double)half));
+    while (bound * bound > half)
+    {
+        --bound;
+    }
+    while ((bound + 1) * (bound + 1) <= half)
+    {
+        ++bound;
+    }
+
+    // extended Euclid on (m, u) stopped as soon as the remainder is under the bound
+    __int128 r0 = m, r1 = u % m;
+    __int128 t0 = 0, t1 = 1;
+    while ((unsigned __int128)(r1) > bound)
+    {
+        __int128 q = r0 / r1;
+        __int128 r = r0 - q * r1;
+        r0 = r1;
+        r1 = r;
+        __int128 t = t0 - q * t1;
+        t0 = t1;
+        t1 = t;
+    }
+    __int128 d = (t1 < 0 ? -t1 : t1);
+    __int128 n = (t1 < 0 ? -r1 : r1);
+    if (d == 0 || (unsigned __int128)(d) > bound)
+    {
+        return std::nullopt;
+    }
+    __int128 a = d, b = (n < 0 ? -n : n);
+    while (b != 0)
+    {
+        __int128 r = a % b;
+        a = b;
+        b = r;
+    }
+    if (a != 1 || n > std::numeric_limits<T>::max() || n < -__int128(std::numeric_limits<T>::max()) || d > std::numeric_limits<T>::max())
+    {
+        return std::nullopt;
+    }
+    Rational<T> ratio;
+    ratio.set_numerator(T(n));
+    ratio.set_denominator(T(d));
+    return ratio;
+}
+
+/// \brief return true if ratio = residue modulo p (used to check that a reconstruction is stable on a prime it didn't use)
+/// \tparam T : int
+/// \param ratio : reconstructed Rational
+/// \param residue : residue modulo p
+/// \param p : prime
+template<typename T>
+bool rational_matches(const Rational<T>& ratio, const uint64_t& residue, const uint64_t& p)
+{
+    MontgomeryField field(p);
+    std::optional<uint64_t> value = field.from_rational(ratio);
+    return value && field.from_montgomery(*value) == residue;
+}
+
+/// \brief rebuild a Rational from its residues : reconstruct with the first prime, then the first two (CRT),
+/// and accept the first candidate that matches every remaining prime
+/// \details the product of 2 primes already fills the unsigned __int128 of the reconstruction, the other primes only confirm
+/// the candidate : when this fails, more primes can't help, only a larger type
+/// \tparam T : int
+/// \param residues : residues, one per prime
+/// \param primes : distinct primes lower than 2^63
+/// \param confirmations : minimum number of remaining primes a candidate must match to be accepted
+template<typename T>
+std::optional<Rational<T>> reconstruct(const std::vector<uint64_t>& residues, const std::vector<uint64_t>& primes, const size_t confirmations = 0)
+{
+    for (size_t used = 1; used <= 2 && used + confirmations <= primes.size(); ++used)
+    {
+        unsigned __int128 u = residues[0];
+        unsigned __int128 m = primes[0];
+        if (used == 2)
+        {
+            u = crt_combine(residues[0], primes[0], residues[1], primes[1]);
+            m *= primes[1];
+        }
+        std::optional<Rational<T>> candidate = rational_reconstruction<T>(u, m);
+        if (!candidate)
+        {
+            continue;
+        }
+        bool stable = true;
+        for (size_t i = used; i < primes.size() && stable; ++i)
+        {
+            stable = rational_matches(*candidate, residues[i], primes[i]);
+        }
+        if (stable)
+        {
+            return candidate;
+        }
+    }
+    return std::nullopt;
+}
+
+/// \class ModularNumber
+/// \brief a rational number stored as its residues modulo several 63-bit primes, the arithmetic never grows
+/// \details residues where the value is undefined (denominator multiple of the prime) are dropped, to_rational() uses the others
+class ModularNumber
+{
+    public:
+        /// \brief the value ratio modulo each prime
+        /// \tparam T : int
+        /// \param primes : distinct primes lower than 2^63, see MontgomeryField::largest_primes
+        /// \param ratio : the value
+        template<typename T>
+        ModularNumber(const std::vector<uint64_t>& primes, const Rational<T>& ratio)
+        {
+            for (uint64_t p : primes)
+            {
+                m_fields.emplace_back(p);
+                std::optional<uint64_t> value = m_fields.back().from_rational(ratio);
+                m_residues.push_back(value ? *value : undefined);
+            }
+        }
+
+    private:
+        static constexpr uint64_t undefined = ~uint64_t(0); /**< residue of a prime where the value is undefined, never a valid residue */
+
+        std::vector<MontgomeryField> m_fields; /**< one field per prime */
+        std::vector<uint64_t> m_residues; /**< Montgomery forms, one per prime */
+
+        template<typename Op>
+        ModularNumber apply(const ModularNumber& other, Op op) const
+        {
+            if (m_fields.size() != other.m_fields.size())
+            {
+                throw std::invalid_argument("numbers must use the same primes");
+            }
+            ModularNumber result = *this;
+            for (size_t i = 0; i < m_fields.size(); ++i)
+            {
+                result.m_residues[i] = (m_residues[i] == undefined || other.m_residues[i] == undefined ? undefined : op(m_fields[i], m_residues[i], other.m_residues[i]));
+            }
+            return result;
+        }
+
+    public:
+        //Functions
+
+        /// \brief return the number of primes where the value is defined
+        size_t defined_residues() const
+        {
+            return size_t(std::count_if(m_residues.begin(), m_residues.end(), [](uint64_t r) { return r != undefined; }));
+        }
+
+        /// \brief return the exact Rational (CRT + rational reconstruction), throws std::overflow_error if the primes are not enough
+        /// \tparam T : int
+        template<typename T>
+        Rational<T> to_rational() const
+        {
+            std::vector<uint64_t> residues, primes;
+            for (size_t i = 0; i < m_fields.size(); ++i)
+            {
+                if (m_residues[i] != undefined)
+                {
+                    residues.push_back(m_fields[i].from_montgomery(m_residues[i]));
+                    primes.push_back(m_fields[i].modulus());
+                }
+            }
+            std::optional<Rational<T>> ratio = (primes.empty() ? std::nullopt : reconstruct<T>(residues, primes));
+            if (!ratio)
+            {
+                throw std::overflow_error("unable to reconstruct the Rational, it needs a larger type");
+            }
+            return *ratio;
+        }
+
+        //Operators
+
+        /// \brief sum of 2 ModularNumber
+        ModularNumber operator+(const ModularNumber& other) const
+        {
+            return apply(other, [](const MontgomeryField& f, uint64_t a, uint64_t b) { return f.add(a, b); });
+        }
+
+        /// \brief subtraction of 2 ModularNumber
+        ModularNumber operator-(const ModularNumber& other) const
+        {
+            return apply(other, [](const MontgomeryField& f, uint64_t a, uint64_t b) { return f.sub(a, b); });
+        }
+
+        /// \brief multiplication of 2 ModularNumber
+        ModularNumber operator*(const ModularNumber& other) const
+        {
+            return apply(other, [](const MontgomeryField& f, uint64_t a, uint64_t b) { return f.mul(a, b); });
+        }
+
+        /// \brief division of 2 ModularNumber, the residues where the divisor is 0 become undefined
+        ModularNumber operator/(const ModularNumber& other) const
+        {
+            return apply(other, [](const MontgomeryField& f, uint64_t a, uint64_t b) { return (b == 0 ? undefined : f.mul(a, f.inverse(b))); });
+        }
+};
+
+/// \brief run a computation modulo several primes in parallel and rebuild its exact Rational results
+/// \details primes are processed by batches of 2 threads, and we stop as soon as every result reconstructed from the
+/// primes seen so far is confirmed by a prime it didn't use (a whole hardware_concurrency batch would run every prime at once)
+/// \tparam T : int
+/// \tparam F : callable (const MontgomeryField&) -> std::optional<std::vector<uint64_t>>, the results modulo p (not in Montgomery form),
+/// std::nullopt if p is unlucky (a denominator or a pivot vanishes modulo p)
+/// \param computation : the computation to run modulo each prime
+/// \param max_primes : throws std::overflow_error if the results are not stable after this number of primes,
+/// std::invalid_argument if less than 2 primes were lucky (for instance a singular system)
+template<typename T, typename F>
+std::vector<Rational<T>> multi_modular(F computation, const size_t max_primes = 8)
+{
+    std::vector<uint64_t> candidates = MontgomeryField::largest_primes(max_primes);
+    const size_t batch = 2;
+
+    std::vector<uint64_t> primes;
+    std::vector<std::vector<uint64_t>> results; // results[prime][component]
+    for (size_t start = 0; start < candidates.size(); start += batch)
+    {
+        std::vector<std::future<std::optional<std::vector<uint64_t>>>> futures;
+        for (size_t i = start; i < std::min(start + batch, candidates.size()); ++i)
+        {
+            futures.push_back(std::async(std::launch::async, [&computation, p = candidates[i]]() { return computation(MontgomeryField(p)); }));
+        }
+        for (size_t i = 0; i < futures.size(); ++i)
+        {
+            std::optional<std::vector<uint64_t>> result = futures[i].get();
+            if (result)
+            {
+                primes.push_back(candidates[start + i]);
+                results.push_back(std::move(*result));
+            }
+        }
+        if (primes.size() < 2)
+        {
+            continue;
+        }
+
+        std::vector<Rational<T>> ratios;
+        for (size_t component = 0; component < results[0].size(); ++component)
+        {
+            std::vector<uint64_t> residues;
+            for (const std::vector<uint64_t>& result : results)
+            {
+                residues.push_back(result[component]);
+            }
+            // the candidate must be confirmed by at least one prime it didn't use
+            std::optional<Rational<T>> ratio = reconstruct<T>(residues, primes, 1);
+            if (!ratio)
+            {
+                break;
+            }
+            ratios.push_back(*ratio);
+        }
+        if (ratios.size() == results[0].size())
+        {
+            return ratios;
+        }
+    }
+    if (primes.size() < 2)
+    {
+        throw std::invalid_argument("computation is undefined modulo almost every prime");
+    }
+    throw std::overflow_error("multi-modular results are not stable, they need a larger type");
+}
+
+/// \brief exact solution of a square linear system A x = b, by Gaussian elimination modulo each prime and rational reconstruction
+/// \tparam T : int
+/// \param A : square invertible matrix, A[i] is the i-th row
+/// \param b : right hand side
+/// \param max_primes : see multi_modular
+template<typename T>
+std::vector<Rational<T>> modular_solve(const std::vector<std::vector<Rational<T>>>& A, const std::vector<Rational<T>>& b, const size_t max_primes = 8)
+{
+    const size_t n = A.size();
+    if (b.size() != n)
+    {
+        throw std::invalid_argument("dimensions of A and b don't match");
+    }
+    for (const std::vector<Rational<T>>& row : A)
+    {
+        if (row.size() != n)
+        {
+            throw std::invalid_argument("matrix must be square");
+        }
+    }
+
+    auto solve_modulo = [&A, &b, n](const MontgomeryField& field) -> std::optional<std::vector<uint64_t>>
+    {
+        // augmented matrix [A | b] in Montgomery form
+        std::vector<std::vector<uint64_t>> M(n, std::vector<uint64_t>(n + 1));
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j <= n; ++j)
+            {
+                std::optional<uint64_t> value = field.from_rational(j < n ? A[i][j] : b[i]);
+                if (!value)
+                {
+                    return std::nullopt;
+                }
+                M[i][j] = *value;
+            }
+        }
+        for (size_t col = 0; col < n; ++col)
+        {
+            size_t pivot = col;
+            while (pivot < n && M[pivot][col] == 0)
+            {
+                ++pivot;
+            }
+            if (pivot == n)
+            {
+                return std::nullopt;
+            }
+            std::swap(M[pivot], M[col]);
+            uint64_t inverse = field.inverse(M[col][col]);
+            for (size_t j = col; j <= n; ++j)
+            {
+                M[col][j] = field.mul(M[col][j], inverse);
+            }
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (i != col && M[i][col] != 0)
+                {
+                    uint64_t factor = M[i][col];
+                    for (size_t j = col; j <= n; ++j)
+                    {
+                        M[i][j] = field.sub(M[i][j], field.mul(factor, M[col][j]));
+                    }
+                }
+            }
+        }
+        std::vector<uint64_t> x(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            x[i] = field.from_montgomery(M[i][n]);
+        }
+        return x;
+    };
+
+    return multi_modular<T>(solve_modulo, max_primes);
+}
+
+#endif
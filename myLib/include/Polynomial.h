@@ -0,0 +1,1290 @@
+#ifndef Polynomial_H
+#define Polynomial_H
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Rational.h"
+#include "WideInt.h"
+#include "MultiModular.h"
+
+/// \namespace polynomial_detail
+/// \brief coefficient vectors (lowest degree first) and the integer forms used by the evaluations and the root isolation
+namespace polynomial_detail
+{
+    /// \brief exact integers for the signs of the root isolation, the number of bits is checked before every evaluation
+    using Wide = WideInt<32>;
+
+    /// \brief return a * b, throws std::overflow_error if it doesn't fit in T
+    template<typename T>
+    T checked_mul(const T& a, const T& b)
+    {
+        T result;
+        if (__builtin_mul_overflow(a, b, &result))
+        {
+            throw std::overflow_error("integer overflow");
+        }
+        return result;
+    }
+
+    /// \brief return a + b, throws std::overflow_error if it doesn't fit in T
+    template<typename T>
+    T checked_add(const T& a, const T& b)
+    {
+        T result;
+        if (__builtin_add_overflow(a, b, &result))
+        {
+            throw std::overflow_error("integer overflow");
+        }
+        return result;
+    }
+
+    /// \brief return a - b, throws std::overflow_error if it doesn't fit in T
+    template<typename T>
+    T checked_sub(const T& a, const T& b)
+    {
+        T result;
+        if (__builtin_sub_overflow(a, b, &result))
+        {
+            throw std::overflow_error("integer overflow");
+        }
+        return result;
+    }
+
+    /// \brief number of bits of |value|
+    template<typename T>
+    int bit_length(const T& value)
+    {
+        int bits = 0;
+        for (T magnitude = (value < 0 ? -value : value); magnitude != 0; magnitude /= 2)
+        {
+            ++bits;
+        }
+        return bits;
+    }
+
+    /// \brief a + b, the shorter one padded with zeros
+    template<typename T>
+    std::vector<Rational<T>> add(const std::vector<Rational<T>>& a, const std::vector<Rational<T>>& b)
+    {
+        std::vector<Rational<T>> result(std::max(a.size(), b.size()));
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            result[i] = (i < a.size() ? (i < b.size() ? a[i] + b[i] : a[i]) : b[i]);
+        }
+        return result;
+    }
+
+    /// \brief a - b, the shorter one padded with zeros
+    template<typename T>
+    std::vector<Rational<T>> subtract(const std::vector<Rational<T>>& a, const std::vector<Rational<T>>& b)
+    {
+        std::vector<Rational<T>> result(std::max(a.size(), b.size()));
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            result[i] = (i < a.size() ? (i < b.size() ? a[i] - b[i] : a[i]) : -b[i]);
+        }
+        return result;
+    }
+
+    /// \brief a * b in O(n m) products
+    template<typename T>
+    std::vector<Rational<T>> schoolbook(const std::vector<Rational<T>>& a, const std::vector<Rational<T>>& b)
+    {
+        if (a.empty() || b.empty())
+        {
+            return {};
+        }
+        std::vector<Rational<T>> result(a.size() + b.size() - 1);
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].get_numerator() == 0)
+            {
+                continue;
+            }
+            for (size_t j = 0; j < b.size(); ++j)
+            {
+                if (b[j].get_numerator() != 0)
+                {
+                    result[i + j] += a[i] * b[j];
+                }
+            }
+        }
+        return result;
+    }
+
+    /// \brief a * b by Karatsuba (3 half size products instead of 4), schoolbook under `threshold` coefficients
+    template<typename T>
+    std::vector<Rational<T>> karatsuba(const std::vector<Rational<T>>& a, const std::vector<Rational<T>>& b, const size_t threshold)
+    {
+        if (std::min(a.size(), b.size()) < std::max(threshold, size_t(2)))
+        {
+            return schoolbook(a, b);
+        }
+        // a = a0 + x^half a1, b = b0 + x^half b1
+        const size_t half = (std::max(a.size(), b.size()) + 1) / 2;
+        auto split = [half](const std::vector<Rational<T>>& v)
+        {
+            const size_t cut = std::min(half, v.size());
+            return std::make_pair(std::vector<Rational<T>>(v.begin(), v.begin() + cut), std::vector<Rational<T>>(v.begin() + cut, v.end()));
+        };
+        auto [a0, a1] = split(a);
+        auto [b0, b1] = split(b);
+        std::vector<Rational<T>> low = karatsuba(a0, b0, threshold);
+        std::vector<Rational<T>> high = karatsuba(a1, b1, threshold);
+        std::vector<Rational<T>> middle = subtract(subtract(karatsuba(add(a0, a1), add(b0, b1), threshold), low), high);
+
+        std::vector<Rational<T>> result(a.size() + b.size() - 1);
+        auto accumulate = [&result](const std::vector<Rational<T>>& part, const size_t shift)
+        {
+            for (size_t i = 0; i < part.size() && i + shift < result.size(); ++i)
+            {
+                if (part[i].get_numerator() != 0)
+                {
+                    result[i + shift] += part[i];
+                }
+            }
+        };
+        accumulate(low, 0);
+        accumulate(middle, half);
+        accumulate(high, 2 * half);
+        return result;
+    }
+
+    /// \brief integer coefficients a divided by the gcd of their magnitudes (positive), without trailing zeros
+    /// \param positive_leading : also change the sign so that the leading coefficient is positive
+    template<typename T>
+    std::vector<T> primitive(std::vector<T> a, const bool positive_leading)
+    {
+        while (!a.empty() && a.back() == 0)
+        {
+            a.pop_back();
+        }
+        if (a.empty())
+        {
+            return a;
+        }
+        T divisor = 0;
+        for (const T& coefficient : a)
+        {
+            divisor = std::gcd(divisor, coefficient);
+        }
+        if (positive_leading && a.back() < 0)
+        {
+            divisor = -divisor;
+        }
+        for (T& coefficient : a)
+        {
+            coefficient /= divisor;
+        }
+        return a;
+    }
+
+    /// \brief integer coefficients on Wide
+    template<typename T>
+    std::vector<Wide> widen(const std::vector<T>& a)
+    {
+        std::vector<Wide> result;
+        for (const T& coefficient : a)
+        {
+            result.push_back(wide_detail::wide<32>(coefficient));
+        }
+        return result;
+    }
+
+    /// \brief integer coefficients back in T, throws std::overflow_error if one doesn't fit
+    template<typename T>
+    std::vector<T> narrow(const std::vector<Wide>& a)
+    {
+        std::vector<T> result;
+        for (const Wide& coefficient : a)
+        {
+            const long long value = coefficient.to_long_long();
+            if (value < (long long)(std::numeric_limits<T>::min()) || value > (long long)(std::numeric_limits<T>::max()))
+            {
+                throw std::overflow_error("integer overflow");
+            }
+            result.push_back(T(value));
+        }
+        return result;
+    }
+
+    /// \brief a divided by the gcd of its coefficients (positive, so the signs are kept)
+    /// \param trim : also remove the trailing zeros
+    inline std::vector<Wide> reduce_content(std::vector<Wide> a, const bool trim = true)
+    {
+        while (trim && !a.empty() && a.back().sign() == 0)
+        {
+            a.pop_back();
+        }
+        Wide content;
+        for (const Wide& coefficient : a)
+        {
+            content = wide_detail::gcd(content, coefficient);
+        }
+        if (Wide(1) < content)
+        {
+            for (Wide& coefficient : a)
+            {
+                coefficient = coefficient / content;
+            }
+        }
+        return a;
+    }
+
+    /// \brief derivative of integer coefficients
+    inline std::vector<Wide> derivative(const std::vector<Wide>& a)
+    {
+        std::vector<Wide> result;
+        for (size_t i = 1; i < a.size(); ++i)
+        {
+            result.push_back(a[i] * Wide((long long)(i)));
+        }
+        return result;
+    }
+
+    /// \brief c * rem(a, b) on integers, with c = lc(b)^(deg a - deg b + 1) / g and g > 0 : the fraction free pseudo remainder,
+    /// made primitive after every step to keep the coefficients small, throws std::overflow_error if they outgrow Wide
+    /// \param a : dividend, without trailing zeros
+    /// \param b : divisor, without trailing zeros and not 0
+    inline std::vector<Wide> pseudo_remainder(std::vector<Wide> a, const std::vector<Wide>& b)
+    {
+        // every step multiplies by lead and adds a product of 2 coefficients, they must stay under half of Wide
+        const Wide limit = Wide(1) << (64 * 32 / 2 - 2);
+        const Wide lead = b.back();
+        for (const Wide& coefficient : b)
+        {
+            if (!(coefficient < limit) || !(-limit < coefficient))
+            {
+                throw std::overflow_error("polynomial remainders too large");
+            }
+        }
+        // exactly deg a - deg b + 1 steps, a top coefficient that is already 0 is a step too (the power of lc(b) keeps its parity)
+        const size_t steps = (a.size() >= b.size() ? a.size() - b.size() + 1 : 0);
+        for (size_t step = 0; step < steps; ++step)
+        {
+            // a = lead a - a_top x^shift b, the top coefficient cancels
+            const Wide factor = a.back();
+            const size_t shift = a.size() - b.size();
+            for (Wide& coefficient : a)
+            {
+                if (!(coefficient < limit) || !(-limit < coefficient))
+                {
+                    throw std::overflow_error("polynomial remainders too large");
+                }
+                coefficient = coefficient * lead;
+            }
+            for (size_t j = 0; j < b.size(); ++j)
+            {
+                a[shift + j] = a[shift + j] - factor * b[j];
+            }
+            a.pop_back();
+            a = reduce_content(a, false);
+        }
+        return reduce_content(a);
+    }
+
+    /// \brief gcd of integer coefficients with a positive leading coefficient (primitive remainder sequence), 0 if both are 0
+    inline std::vector<Wide> gcd(const std::vector<Wide>& a, const std::vector<Wide>& b)
+    {
+        std::vector<Wide> x = reduce_content(a);
+        std::vector<Wide> y = reduce_content(b);
+        while (!y.empty())
+        {
+            std::vector<Wide> remainder = pseudo_remainder(x, y);
+            x = y;
+            y = remainder;
+        }
+        if (!x.empty() && x.back().sign() < 0)
+        {
+            for (Wide& coefficient : x)
+            {
+                coefficient = -coefficient;
+            }
+        }
+        return reduce_content(x);
+    }
+
+    /// \brief a / b on integers when b divides a with an integer quotient (b primitive, Gauss' lemma), checked
+    template<typename T>
+    std::vector<T> exact_quotient(std::vector<T> a, const std::vector<T>& b)
+    {
+        std::vector<T> quotient(a.size() - b.size() + 1);
+        const size_t d = b.size() - 1;
+        for (size_t i = quotient.size(); i-- > 0;)
+        {
+            quotient[i] = a[i + d] / b.back();
+            for (size_t j = 0; j <= d; ++j)
+            {
+                a[i + j] = checked_sub(a[i + j], checked_mul(quotient[i], b[j]));
+            }
+        }
+        return quotient;
+    }
+
+    /// \brief value * 2^bits
+    inline Wide shifted(Wide value, size_t bits)
+    {
+        for (; bits > 0; bits -= std::min<size_t>(bits, 62))
+        {
+            value = value * Wide((long long)(1) << std::min<size_t>(bits, 62));
+        }
+        return value;
+    }
+
+    /// \brief a(x) -> a(x + 1) in place, O(n^2) additions
+    inline void taylor_shift(std::vector<Wide>& a)
+    {
+        for (size_t i = 0; i + 1 < a.size(); ++i)
+        {
+            for (size_t j = a.size() - 1; j-- > i;)
+            {
+                a[j] = a[j] + a[j + 1];
+            }
+        }
+    }
+
+    /// \brief a(x) -> 2^n a(x / 2), n the degree : its roots in ]0, 1/2[ become the roots in ]0, 1[
+    inline std::vector<Wide> halve(const std::vector<Wide>& a)
+    {
+        std::vector<Wide> result(a.size());
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            result[i] = shifted(a[i], a.size() - 1 - i);
+        }
+        return result;
+    }
+
+    /// \brief Descartes' bound on the roots of a in ]0, 1[ : sign variations of (x + 1)^n a(1 / (x + 1)), exact if 0 or 1
+    inline int descartes_unit(const std::vector<Wide>& a)
+    {
+        std::vector<Wide> transformed(a.rbegin(), a.rend());
+        taylor_shift(transformed);
+        int variations = 0;
+        int last = 0;
+        for (const Wide& coefficient : transformed)
+        {
+            int sign = coefficient.sign();
+            if (sign != 0)
+            {
+                variations += (last != 0 && sign != last);
+                last = sign;
+            }
+        }
+        return variations;
+    }
+
+    /// \brief degree of gcd(a, b) modulo the prime of field (-1 if both are 0), residues in Montgomery form lowest degree first
+    inline int modular_gcd_degree(const MontgomeryField& field, std::vector<uint64_t> a, std::vector<uint64_t> b)
+    {
+        auto trim = [](std::vector<uint64_t>& v)
+        {
+            while (!v.empty() && v.back() == 0)
+            {
+                v.pop_back();
+            }
+        };
+        trim(a);
+        trim(b);
+        while (!b.empty())
+        {
+            const uint64_t inverse = field.inverse(b.back());
+            while (a.size() >= b.size())
+            {
+                const uint64_t factor = field.mul(a.back(), inverse);
+                const size_t shift = a.size() - b.size();
+                for (size_t j = 0; j < b.size(); ++j)
+                {
+                    a[shift + j] = field.sub(a[shift + j], field.mul(factor, b[j]));
+                }
+                trim(a);
+            }
+            std::swap(a, b);
+        }
+        return int(a.size()) - 1;
+    }
+
+    /// \brief a polynomial with integer coefficients (lowest degree first), what the batched evaluations run on
+    template<typename T>
+    struct IntegerForm
+    {
+        std::vector<T> coefficients; /**< integer coefficients, lowest degree first */
+
+        /// \brief numerator of P(p/q) q^degree = sum c_i p^i q^(degree - i), throws std::overflow_error if it doesn't fit in T
+        T homogeneous(const T& p, const T& q, T& q_power) const
+        {
+            T value = coefficients.back();
+            q_power = 1;
+            for (size_t i = coefficients.size() - 1; i-- > 0;)
+            {
+                q_power = checked_mul(q_power, q);
+                value = checked_add(checked_mul(value, p), checked_mul(coefficients[i], q_power));
+            }
+            return value;
+        }
+    };
+
+    /// \brief a polynomial with integer coefficients on Wide (lowest degree first), what the exact signs run on
+    struct WideForm
+    {
+        std::vector<Wide> coefficients; /**< integer coefficients, lowest degree first, not empty */
+        std::vector<long double> approximations; /**< the coefficients rounded to long double */
+        int bits = 0; /**< bits of the largest coefficient */
+
+        /// \brief value constructor
+        /// \param c : integer coefficients, lowest degree first, not empty
+        explicit WideForm(const std::vector<Wide>& c) : coefficients(c)
+        {
+            for (const Wide& coefficient : coefficients)
+            {
+                approximations.push_back(coefficient.to_long_double());
+                bits = std::max(bits, int(coefficient.bit_length()));
+            }
+        }
+
+        /// \brief sign of P(x), a long double filter first then the exact value on Wide
+        template<typename T>
+        int sign(const Rational<T>& x) const
+        {
+            const T& p = x.get_numerator();
+            const T& q = x.get_denominator();
+            const size_t degree = coefficients.size() - 1;
+
+            // Horner's error is below (2 degree) u sum |c_i x^i|, the roundings of x and of the coefficients add degree + 1 u more
+            long double value = approximations.back();
+            long double permanent = std::fabs(value);
+            const long double point = (long double)p / (long double)q;
+            for (size_t i = degree; i-- > 0;)
+            {
+                value = value * point + approximations[i];
+                permanent = permanent * std::fabs(point) + std::fabs(approximations[i]);
+            }
+            const long double bound = (5 * degree + 5) * std::numeric_limits<long double>::epsilon() * permanent;
+            if (std::isfinite(value) && std::isfinite(permanent))
+            {
+                if (value > bound)
+                {
+                    return 1;
+                }
+                if (-value > bound)
+                {
+                    return -1;
+                }
+            }
+
+            // exact homogeneous value, sum c_i p^i q^(degree - i) has the sign of P(x) since q > 0
+            if (bits + int(degree) * std::max(bit_length(p), bit_length(q)) + bit_length(degree + 1) + 2 >= 64 * 32)
+            {
+                throw std::overflow_error("polynomial values too large for an exact sign");
+            }
+            Wide exact = coefficients.back();
+            Wide q_power = 1;
+            const Wide wide_p = wide_detail::wide<32>(p), wide_q = wide_detail::wide<32>(q);
+            for (size_t i = degree; i-- > 0;)
+            {
+                q_power = q_power * wide_q;
+                exact = exact * wide_p + coefficients[i] * q_power;
+            }
+            return exact.sign();
+        }
+    };
+}
+
+/// \class RationalPolynomial
+/// \brief polynomial with Rational coefficients : exact arithmetic, evaluation, interpolation and real root isolation
+/// \details coefficients are stored lowest degree first and without trailing zeros, the zero polynomial has no coefficient and
+/// a degree of -1. Arithmetic is done with Rational<T>, so intermediate numerators and denominators must fit in T. Real roots are
+/// isolated by Descartes' method on exact wide integers and counted by Sturm sequences (signs from a floating point filter and
+/// exact wide integers behind it)
+/// \tparam T : int
+template<typename T = long long>
+class RationalPolynomial
+{
+    public:
+        /// \brief a root r in ]low, high[, or low == high == r when the root is this Rational
+        using Interval = std::pair<Rational<T>, Rational<T>>;
+
+        /// \brief number of coefficients from which operator* uses Karatsuba instead of the schoolbook product
+        static constexpr size_t karatsuba_threshold = 32;
+
+        //constructors
+
+        /// \brief default constructor, the zero polynomial
+        RationalPolynomial() = default;
+
+        /// \brief value constructor
+        /// \param coefficients : coefficients, lowest degree first
+        RationalPolynomial(const std::vector<Rational<T>>& coefficients) : m_coefficients(coefficients)
+        {
+            trim();
+        }
+
+        /// \brief value constructor, {1, 0, 2} is 1 + 2x^2
+        /// \param coefficients : coefficients, lowest degree first
+        RationalPolynomial(std::initializer_list<Rational<T>> coefficients) : m_coefficients(coefficients)
+        {
+            trim();
+        }
+
+        /// \brief return coefficient x^degree
+        /// \param coefficient : the coefficient
+        /// \param degree : the degree
+        static RationalPolynomial monomial(const Rational<T>& coefficient, const size_t degree)
+        {
+            std::vector<Rational<T>> coefficients(degree + 1);
+            coefficients[degree] = coefficient;
+            return RationalPolynomial(coefficients);
+        }
+
+        /// \brief return the monic polynomial (x - r0)(x - r1)...
+        /// \param roots : the roots, repeated for multiple roots
+        static RationalPolynomial from_roots(const std::vector<Rational<T>>& roots)
+        {
+            RationalPolynomial result({Rational<T>(1, 1)});
+            for (const Rational<T>& root : roots)
+            {
+                result *= RationalPolynomial({-root, Rational<T>(1, 1)});
+            }
+            return result;
+        }
+
+        /// \brief default destructor
+        ~RationalPolynomial() = default;
+
+    private:
+        std::vector<Rational<T>> m_coefficients; /**< coefficients, lowest degree first, no trailing zero */
+
+        /// \brief remove the trailing zeros
+        void trim()
+        {
+            while (!m_coefficients.empty() && m_coefficients.back().get_numerator() == 0)
+            {
+                m_coefficients.pop_back();
+            }
+        }
+
+    public:
+        //Functions
+
+        /// \brief return the degree, -1 for the zero polynomial
+        int degree() const { return int(m_coefficients.size()) - 1; }
+
+        /// \brief return true for the zero polynomial
+        bool is_zero() const { return m_coefficients.empty(); }
+
+        /// \brief return the coefficients, lowest degree first
+        const std::vector<Rational<T>>& coefficients() const { return m_coefficients; }
+
+        /// \brief return the leading coefficient, 0 for the zero polynomial
+        Rational<T> leading_coefficient() const { return (is_zero() ? Rational<T>() : m_coefficients.back()); }
+
+        /// \brief return P(x) by Horner's scheme
+        /// \param x : the point
+        Rational<T> evaluate(const Rational<T>& x) const
+        {
+            Rational<T> value;
+            for (size_t i = m_coefficients.size(); i-- > 0;)
+            {
+                value = value * x + m_coefficients[i];
+            }
+            return value;
+        }
+
+        /// \brief return P at every point
+        /// \details the primitive integer form of P is computed once, then every point p/q runs Horner's scheme on integers
+        /// (sum c_i p^i q^(n - i)) with a single gcd at the end instead of one per coefficient. A point whose integer form
+        /// overflows T falls back to the Rational Horner scheme
+        /// \param points : the points
+        std::vector<Rational<T>> evaluate(const std::vector<Rational<T>>& points) const
+        {
+            std::vector<Rational<T>> values;
+            values.reserve(points.size());
+            if (is_zero())
+            {
+                values.resize(points.size());
+                return values;
+            }
+            const Rational<T> scale = content();
+            const polynomial_detail::IntegerForm<T> form = integer_form();
+            for (const Rational<T>& x : points)
+            {
+                try
+                {
+                    T q_power;
+                    T numerator = form.homogeneous(x.get_numerator(), x.get_denominator(), q_power);
+                    values.push_back(scale * Rational<T>(numerator, q_power));
+                }
+                catch (const std::overflow_error&)
+                {
+                    values.push_back(evaluate(x));
+                }
+            }
+            return values;
+        }
+
+        /// \brief return the derivative
+        RationalPolynomial derivative() const
+        {
+            std::vector<Rational<T>> coefficients;
+            for (size_t i = 1; i < m_coefficients.size(); ++i)
+            {
+                coefficients.push_back(m_coefficients[i] * T(i));
+            }
+            return RationalPolynomial(coefficients);
+        }
+
+        /// \brief return (quotient, remainder) with P = quotient * divisor + remainder and deg(remainder) < deg(divisor)
+        /// \param divisor : throws std::invalid_argument if it is the zero polynomial
+        std::pair<RationalPolynomial, RationalPolynomial> divide(const RationalPolynomial& divisor) const
+        {
+            if (divisor.is_zero())
+            {
+                throw std::invalid_argument("division by the zero polynomial");
+            }
+            if (degree() < divisor.degree())
+            {
+                return {RationalPolynomial(), *this};
+            }
+            std::vector<Rational<T>> remainder = m_coefficients;
+            std::vector<Rational<T>> quotient(m_coefficients.size() - divisor.m_coefficients.size() + 1);
+            const Rational<T> lead = divisor.leading_coefficient().reverse();
+            const size_t d = divisor.m_coefficients.size() - 1;
+            for (size_t i = quotient.size(); i-- > 0;)
+            {
+                Rational<T> factor = remainder[i + d] * lead;
+                quotient[i] = factor;
+                if (factor.get_numerator() == 0)
+                {
+                    continue;
+                }
+                for (size_t j = 0; j <= d; ++j)
+                {
+                    remainder[i + j] -= factor * divisor.m_coefficients[j];
+                }
+            }
+            remainder.resize(d);
+            return {RationalPolynomial(quotient), RationalPolynomial(remainder)};
+        }
+
+        /// \brief return the content c, P = c * primitive_part() : gcd of the numerators over lcm of the denominators, with the
+        /// sign of the leading coefficient (0 for the zero polynomial), throws std::overflow_error if the lcm doesn't fit in T
+        Rational<T> content() const
+        {
+            if (is_zero())
+            {
+                return Rational<T>();
+            }
+            T multiple = 1;
+            for (const Rational<T>& coefficient : m_coefficients)
+            {
+                multiple = polynomial_detail::checked_mul(multiple / std::gcd(multiple, coefficient.get_denominator()), coefficient.get_denominator());
+            }
+            T divisor = 0;
+            for (const Rational<T>& coefficient : m_coefficients)
+            {
+                divisor = std::gcd(divisor, coefficient.get_numerator());
+            }
+            return Rational<T>(leading_coefficient().get_numerator() < 0 ? -divisor : divisor, multiple);
+        }
+
+        /// \brief return the primitive part : integer coefficients without common factor and a positive leading coefficient,
+        /// throws std::overflow_error if they don't fit in T
+        RationalPolynomial primitive_part() const
+        {
+            return from_integers(integer_coefficients());
+        }
+
+        /// \brief return P divided by its leading coefficient
+        RationalPolynomial monic() const
+        {
+            if (is_zero())
+            {
+                return RationalPolynomial();
+            }
+            return *this * leading_coefficient().reverse();
+        }
+
+        /// \brief return the gcd of 2 polynomials as a primitive polynomial, 0 if both are 0
+        /// \details Euclid's algorithm on the integer primitive parts with fraction free pseudo remainders, every remainder is made
+        /// primitive to keep the coefficients small, throws std::overflow_error if they don't fit in T
+        /// \param a : first polynomial
+        /// \param b : second polynomial
+        static RationalPolynomial gcd(const RationalPolynomial& a, const RationalPolynomial& b)
+        {
+            std::vector<polynomial_detail::Wide> common = polynomial_detail::gcd(polynomial_detail::widen(a.integer_coefficients()),
+                                                                                 polynomial_detail::widen(b.integer_coefficients()));
+            return from_integers(polynomial_detail::narrow<T>(common));
+        }
+
+        /// \brief return the polynomial of degree < n through the n points (x_i, y_i), in Lagrange's form
+        /// \details the weights y_i / prod (x_i - x_j) multiply (prod (x - x_j)) / (x - x_i), each quotient obtained by synthetic
+        /// division of the same product, O(n^2) operations
+        /// \param xs : the abscissas, throws std::invalid_argument if 2 of them are equal or if the sizes differ
+        /// \param ys : the values
+        static RationalPolynomial lagrange(const std::vector<Rational<T>>& xs, const std::vector<Rational<T>>& ys)
+        {
+            check_interpolation(xs, ys);
+            RationalPolynomial product = from_roots(xs);
+            std::vector<Rational<T>> result(xs.size());
+            for (size_t i = 0; i < xs.size(); ++i)
+            {
+                if (ys[i].get_numerator() == 0)
+                {
+                    continue;
+                }
+                // product / (x - x_i) by synthetic division
+                std::vector<Rational<T>> quotient(xs.size());
+                Rational<T> carry;
+                for (size_t k = xs.size(); k-- > 0;)
+                {
+                    carry = product.m_coefficients[k + 1] + carry * xs[i];
+                    quotient[k] = carry;
+                }
+                Rational<T> weight = ys[i] / RationalPolynomial(quotient).evaluate(xs[i]);
+                for (size_t k = 0; k < quotient.size(); ++k)
+                {
+                    result[k] += weight * quotient[k];
+                }
+            }
+            return RationalPolynomial(result);
+        }
+
+        /// \brief return the polynomial of degree < n through the n points (x_i, y_i), from Newton's divided differences
+        /// \param xs : the abscissas, throws std::invalid_argument if 2 of them are equal or if the sizes differ
+        /// \param ys : the values
+        static RationalPolynomial newton(const std::vector<Rational<T>>& xs, const std::vector<Rational<T>>& ys)
+        {
+            check_interpolation(xs, ys);
+            std::vector<Rational<T>> differences = ys;
+            for (size_t level = 1; level < xs.size(); ++level)
+            {
+                for (size_t i = xs.size() - 1; i >= level; --i)
+                {
+                    differences[i] = (differences[i] - differences[i - 1]) / (xs[i] - xs[i - level]);
+                }
+            }
+            // c_0 + (x - x_0)(c_1 + (x - x_1)(c_2 + ...))
+            RationalPolynomial result;
+            for (size_t i = xs.size(); i-- > 0;)
+            {
+                result = result * RationalPolynomial({-xs[i], Rational<T>(1, 1)}) + RationalPolynomial({differences[i]});
+            }
+            return result;
+        }
+
+        /// \brief return the number of sign changes of the coefficients, Descartes' bound on the number of positive roots
+        /// (exact when it is 0 or 1, otherwise an upper bound of the same parity)
+        int sign_variations() const
+        {
+            int variations = 0;
+            int last = 0;
+            for (const Rational<T>& coefficient : m_coefficients)
+            {
+                int sign = (coefficient.get_numerator() > 0) - (coefficient.get_numerator() < 0);
+                if (sign != 0)
+                {
+                    variations += (last != 0 && sign != last);
+                    last = sign;
+                }
+            }
+            return variations;
+        }
+
+        /// \brief return the square free part P / gcd(P, P') as a primitive polynomial
+        /// \details a gcd of degree 0 modulo a 63-bit prime that doesn't divide the leading coefficient proves that P is already
+        /// square free, the integer gcd and the exact division only run when P has a multiple root (or the prime is unlucky).
+        /// Throws std::overflow_error if the coefficients don't fit in T
+        RationalPolynomial square_free_part() const
+        {
+            return from_integers(square_free_integers());
+        }
+
+        /// \brief return the Sturm sequence of the square free part of P, as primitive polynomials
+        /// \details S0 = P, S1 = P', S(i+1) = -rem(S(i-1), S(i)), each divided by a positive constant, which keeps the signs.
+        /// The remainders are fraction free pseudo remainders on polynomial_detail::Wide, their content divided out at each
+        /// step. Throws std::overflow_error when a term doesn't fit in T, count_roots() works without it
+        std::vector<RationalPolynomial> sturm_sequence() const
+        {
+            std::vector<RationalPolynomial> sequence;
+            for (const std::vector<polynomial_detail::Wide>& polynomial : sturm_integers())
+            {
+                sequence.push_back(from_integers(polynomial_detail::narrow<T>(polynomial)));
+            }
+            return sequence;
+        }
+
+        /// \brief return the number of distinct real roots in ]low, high] from the Sturm sequence
+        /// \details the sequence stays on polynomial_detail::Wide, it doesn't have to fit in T
+        /// \param low : lower bound, excluded
+        /// \param high : upper bound, included, throws std::invalid_argument if high < low
+        int count_roots(const Rational<T>& low, const Rational<T>& high) const
+        {
+            if (high < low)
+            {
+                throw std::invalid_argument("empty interval");
+            }
+            std::vector<polynomial_detail::WideForm> sturm;
+            for (const std::vector<polynomial_detail::Wide>& polynomial : sturm_integers())
+            {
+                sturm.emplace_back(polynomial);
+            }
+            return variations(sturm, low) - variations(sturm, high);
+        }
+
+        /// \brief return disjoint intervals, in increasing order, each holding one distinct real root of P
+        /// \details Descartes' method (Vincent-Collins-Akritas bisection) on the square free part : the roots of A in ]0, 1[
+        /// are counted by the sign variations of (x + 1)^n A(1 / (x + 1)), exactly when there are 0 or 1 of them, otherwise
+        /// the interval is halved by x -> x / 2 and x -> (x + 1) / 2. The coefficients are exact integers transformed by
+        /// additions and shifts only, so nothing like a Sturm sequence has to fit in T. The intervals are kept as integer
+        /// numerators over powers of 2 and only turned into Rational<T> when a root is returned. Isolated roots are halved down
+        /// to `width`, rational roots met on the way are returned exactly. Throws std::overflow_error if a returned endpoint
+        /// doesn't fit in T or the coefficients outgrow polynomial_detail::Wide
+        /// \param width : largest width of the returned intervals, throws std::invalid_argument if it is not positive
+        std::vector<Interval> isolate_roots(const Rational<T>& width = Rational<T>(1, 1)) const
+        {
+            if (is_zero())
+            {
+                throw std::invalid_argument("every real number is a root of the zero polynomial");
+            }
+            if (width <= Rational<T>())
+            {
+                throw std::invalid_argument("width must be positive");
+            }
+            std::vector<Interval> roots;
+            RationalPolynomial square_free = square_free_part();
+            if (square_free.degree() <= 0)
+            {
+                return roots;
+            }
+            std::vector<T> c;
+            for (const Rational<T>& coefficient : square_free.m_coefficients)
+            {
+                c.push_back(coefficient.get_numerator());
+            }
+
+            // every root is in ]-bound, bound[ (Cauchy), bound = 2^shift so that the bisection points stay dyadic
+            T largest = 0;
+            for (size_t i = 0; i + 1 < c.size(); ++i)
+            {
+                largest = std::max(largest, std::abs(c[i]) / std::abs(c.back()) + 1);
+            }
+            T bound = 1;
+            size_t shift = 0;
+            for (; bound <= largest; ++shift)
+            {
+                bound = polynomial_detail::checked_mul(bound, T(2));
+            }
+            if (bound > std::numeric_limits<T>::max() / 8)
+            {
+                throw std::overflow_error("roots too large for the type");
+            }
+
+            // a simple root at 0 is taken out, then A(x) = P(bound x) and P(-bound x) have their roots in ]0, 1[
+            const bool root_at_zero = (c.front() == 0);
+            if (root_at_zero)
+            {
+                c.erase(c.begin());
+            }
+            auto scaled = [&c, shift](const bool reflect, int& bits)
+            {
+                std::vector<polynomial_detail::Wide> a;
+                for (size_t i = 0; i < c.size(); ++i)
+                {
+                    T coefficient = (reflect && i % 2 == 1 ? -c[i] : c[i]);
+                    a.push_back(polynomial_detail::shifted(wide_detail::wide<32>(coefficient), shift * i));
+                    bits = std::max(bits, polynomial_detail::bit_length(coefficient) + int(shift * i));
+                }
+                return a;
+            };
+            int bits = 0;
+            std::vector<polynomial_detail::Wide> negative_side = scaled(true, bits), positive_side = scaled(false, bits);
+            const Rational<T> zero;
+
+            // the intervals at depth d have length bound / 2^d, the target depth is the first one no wider than width
+            const Dyadic dyadic{shift, target_depth(shift, width)};
+            std::vector<Interval> negative;
+            descartes(negative_side, bits, 0, 0, dyadic, negative);
+            for (auto interval = negative.rbegin(); interval != negative.rend(); ++interval)
+            {
+                roots.push_back({-interval->second, -interval->first});
+            }
+            if (root_at_zero)
+            {
+                roots.push_back({zero, zero});
+            }
+            descartes(positive_side, bits, 0, 0, dyadic, roots);
+            return roots;
+        }
+
+    private:
+        /// \brief throws std::invalid_argument unless xs and ys have the same size and xs are distinct
+        static void check_interpolation(const std::vector<Rational<T>>& xs, const std::vector<Rational<T>>& ys)
+        {
+            if (xs.size() != ys.size())
+            {
+                throw std::invalid_argument("as many abscissas as values are needed");
+            }
+            for (size_t i = 0; i < xs.size(); ++i)
+            {
+                for (size_t j = i + 1; j < xs.size(); ++j)
+                {
+                    if (xs[i] == xs[j])
+                    {
+                        throw std::invalid_argument("abscissas must be distinct");
+                    }
+                }
+            }
+        }
+
+        /// \brief return P(-x)
+        RationalPolynomial reflected() const
+        {
+            std::vector<Rational<T>> coefficients = m_coefficients;
+            for (size_t i = 1; i < coefficients.size(); i += 2)
+            {
+                coefficients[i] = -coefficients[i];
+            }
+            return RationalPolynomial(coefficients);
+        }
+
+        /// \brief return the polynomial of integer coefficients
+        static RationalPolynomial from_integers(const std::vector<T>& coefficients)
+        {
+            std::vector<Rational<T>> result;
+            for (const T& coefficient : coefficients)
+            {
+                result.push_back(Rational<T>(coefficient, T(1)));
+            }
+            return RationalPolynomial(result);
+        }
+
+        /// \brief return the primitive part as integers : numerator / gcd(numerators) * (lcm(denominators) / denominator), checked
+        std::vector<T> integer_coefficients() const
+        {
+            if (is_zero())
+            {
+                return {};
+            }
+            const Rational<T> scale = content();
+            std::vector<T> result;
+            for (const Rational<T>& coefficient : m_coefficients)
+            {
+                result.push_back(polynomial_detail::checked_mul(coefficient.get_numerator() / scale.get_numerator(),
+                                                                scale.get_denominator() / coefficient.get_denominator()));
+            }
+            return result;
+        }
+
+        /// \brief return the primitive part as integers
+        polynomial_detail::IntegerForm<T> integer_form() const
+        {
+            return polynomial_detail::IntegerForm<T>{integer_coefficients()};
+        }
+
+        /// \brief return the square free part as primitive integers, see square_free_part()
+        std::vector<T> square_free_integers() const
+        {
+            std::vector<T> primitive = integer_coefficients();
+            if (primitive.size() <= 2 || square_free_modulo_prime(primitive))
+            {
+                return primitive;
+            }
+            std::vector<polynomial_detail::Wide> wide = polynomial_detail::widen(primitive);
+            std::vector<T> common = polynomial_detail::narrow<T>(polynomial_detail::gcd(wide, polynomial_detail::derivative(wide)));
+            return polynomial_detail::primitive(polynomial_detail::exact_quotient(primitive, common), true);
+        }
+
+        /// \brief return the Sturm sequence on Wide, see sturm_sequence()
+        std::vector<std::vector<polynomial_detail::Wide>> sturm_integers() const
+        {
+            if (is_zero())
+            {
+                throw std::invalid_argument("the zero polynomial has no Sturm sequence");
+            }
+            std::vector<std::vector<polynomial_detail::Wide>> sequence = {polynomial_detail::widen(square_free_integers())};
+            std::vector<polynomial_detail::Wide> next = polynomial_detail::reduce_content(polynomial_detail::derivative(sequence.front()));
+            while (!next.empty())
+            {
+                sequence.push_back(next);
+                const std::vector<polynomial_detail::Wide>& previous = sequence[sequence.size() - 2];
+                // the pseudo remainder is c rem(previous, next) with c of the sign of lc(next)^(deg previous - deg next + 1)
+                next = polynomial_detail::pseudo_remainder(previous, next);
+                const bool positive_factor = (sequence.back().back().sign() > 0 || (previous.size() - sequence.back().size()) % 2 == 1);
+                if (positive_factor)
+                {
+                    for (polynomial_detail::Wide& coefficient : next)
+                    {
+                        coefficient = -coefficient;
+                    }
+                }
+            }
+            return sequence;
+        }
+
+        /// \brief number of sign changes of the Sturm sequence at x, zeros skipped
+        static int variations(const std::vector<polynomial_detail::WideForm>& sturm, const Rational<T>& x)
+        {
+            int result = 0;
+            int last = 0;
+            for (const polynomial_detail::WideForm& form : sturm)
+            {
+                int sign = form.sign(x);
+                if (sign != 0)
+                {
+                    result += (last != 0 && sign != last);
+                    last = sign;
+                }
+            }
+            return result;
+        }
+
+        /// \brief true if gcd(P, P') has degree 0 modulo a large prime
+        /// \param coefficients : integer coefficients of P
+        static bool square_free_modulo_prime(const std::vector<T>& coefficients)
+        {
+            MontgomeryField field(MontgomeryField::largest_primes(1).front());
+            std::vector<uint64_t> residues, derivative;
+            for (const T& coefficient : coefficients)
+            {
+                residues.push_back(field.from_integer((long long)(coefficient)));
+            }
+            if (residues.back() == 0)
+            {
+                return false;
+            }
+            for (size_t i = 1; i < residues.size(); ++i)
+            {
+                derivative.push_back(field.mul(residues[i], field.from_integer((long long)(i))));
+            }
+            return polynomial_detail::modular_gcd_degree(field, residues, derivative) == 0;
+        }
+
+        /// \brief the scale of the bisection : the interval of index m at depth d is ]m, m + 1[ * 2^shift / 2^d
+        struct Dyadic
+        {
+            size_t shift; /**< the roots are in ]-2^shift, 2^shift[ */
+            size_t target; /**< the depth of the returned intervals */
+        };
+
+        /// \brief deepest bisection, so that the indices m < 2^depth and 2 m + 1 fit in __int128
+        static constexpr size_t max_depth = 125;
+
+        /// \brief smallest d with 2^shift / 2^d <= width, on __int128 since 2^shift * denominator can overflow T
+        static size_t target_depth(const size_t shift, const Rational<T>& width)
+        {
+            const __int128 length = (__int128)(width.get_denominator()) << shift;
+            size_t depth = 0;
+            while (((__int128)(width.get_numerator()) << depth) < length)
+            {
+                ++depth;
+            }
+            return depth;
+        }
+
+        /// \brief m 2^shift / 2^depth, throws std::overflow_error if it doesn't fit in T
+        static Rational<T> endpoint(__int128 m, size_t depth, const size_t shift)
+        {
+            for (; depth > shift && m % 2 == 0; --depth)
+            {
+                m /= 2;
+            }
+            if (depth <= shift)
+            {
+                m <<= (shift - depth);
+                depth = shift;
+            }
+            if (depth - shift >= size_t(std::numeric_limits<T>::digits) || m > (__int128)(std::numeric_limits<T>::max()))
+            {
+                throw std::overflow_error("interval too narrow for the type");
+            }
+            return Rational<T>(T(m), T(1) << (depth - shift));
+        }
+
+        /// \brief throws std::overflow_error if coefficients of `bits` bits, transformed `levels` more times, outgrow Wide
+        static void check_bits(const int bits, const int degree, const int levels)
+        {
+            if (bits + levels * (degree + 1) + 2 >= 64 * 32)
+            {
+                throw std::overflow_error("polynomial coefficients too large for the root isolation");
+            }
+        }
+
+        /// \brief append the roots r of the square free part with r / 2^shift * 2^depth - m in ]0, 1[, the roots of A in ]0, 1[
+        /// \details each transformation x -> x / 2 or x -> (x + 1) / 2 (times 2^n) adds at most n + 1 bits to the coefficients
+        static void descartes(const std::vector<polynomial_detail::Wide>& a, const int bits, const __int128 m, const size_t depth,
+                              const Dyadic& dyadic, std::vector<Interval>& roots)
+        {
+            const int degree = int(a.size()) - 1;
+            check_bits(bits, degree, 2);
+            const int count = polynomial_detail::descartes_unit(a);
+            if (count == 0)
+            {
+                return;
+            }
+            if (count == 1)
+            {
+                refine(a, bits, m, depth, dyadic, roots);
+                return;
+            }
+            if (depth >= max_depth)
+            {
+                throw std::overflow_error("roots too close for the root isolation");
+            }
+            std::vector<polynomial_detail::Wide> left = polynomial_detail::halve(a);
+            std::vector<polynomial_detail::Wide> right = left;
+            polynomial_detail::taylor_shift(right);
+            descartes(left, bits + degree + 1, 2 * m, depth + 1, dyadic, roots);
+            if (right.front().sign() == 0)
+            {
+                // the middle is a root, it is divided out of the right half
+                const Rational<T> middle = endpoint(2 * m + 1, depth + 1, dyadic.shift);
+                roots.push_back({middle, middle});
+                right.erase(right.begin());
+            }
+            descartes(right, bits + degree + 1, 2 * m + 1, depth + 1, dyadic, roots);
+        }
+
+        /// \brief append the single root of A in ]0, 1[, halved until the depth of the interval reaches the target
+        /// \details A(0) is not 0 (roots at the left endpoints are divided out), so A changes sign across the root only
+        static void refine(std::vector<polynomial_detail::Wide> a, int bits, __int128 m, size_t depth,
+                           const Dyadic& dyadic, std::vector<Interval>& roots)
+        {
+            const int degree = int(a.size()) - 1;
+            for (; depth < dyadic.target; ++depth)
+            {
+                if (depth >= max_depth)
+                {
+                    throw std::overflow_error("interval too narrow for the type");
+                }
+                check_bits(bits, degree, 1);
+                std::vector<polynomial_detail::Wide> left = polynomial_detail::halve(a);
+                std::vector<polynomial_detail::Wide> right = left;
+                polynomial_detail::taylor_shift(right);
+                bits += degree + 1;
+                const int sign_middle = right.front().sign();
+                if (sign_middle == 0)
+                {
+                    const Rational<T> middle = endpoint(2 * m + 1, depth + 1, dyadic.shift);
+                    roots.push_back({middle, middle});
+                    return;
+                }
+                if (sign_middle == a.front().sign())
+                {
+                    a = right;
+                    m = 2 * m + 1;
+                }
+                else
+                {
+                    a = left;
+                    m = 2 * m;
+                }
+            }
+            roots.push_back({endpoint(m, depth, dyadic.shift), endpoint(m + 1, depth, dyadic.shift)});
+        }
+
+    public:
+        //Operators
+
+        /// \brief coefficient of x^i, 0 over the degree
+        /// \param i : the degree of the coefficient
+        Rational<T> operator[](const size_t i) const { return (i < m_coefficients.size() ? m_coefficients[i] : Rational<T>()); }
+
+        /// \brief return P(x)
+        /// \param x : the point
+        Rational<T> operator()(const Rational<T>& x) const { return evaluate(x); }
+
+        /// \brief sum of 2 polynomials
+        RationalPolynomial operator+(const RationalPolynomial& other) const
+        {
+            return RationalPolynomial(polynomial_detail::add(m_coefficients, other.m_coefficients));
+        }
+
+        /// \brief unary minus operator
+        RationalPolynomial operator-() const
+        {
+            return RationalPolynomial(polynomial_detail::subtract(std::vector<Rational<T>>(), m_coefficients));
+        }
+
+        /// \brief subtraction of 2 polynomials
+        RationalPolynomial operator-(const RationalPolynomial& other) const
+        {
+            return RationalPolynomial(polynomial_detail::subtract(m_coefficients, other.m_coefficients));
+        }
+
+        /// \brief product of 2 polynomials, Karatsuba from karatsuba_threshold coefficients
+        RationalPolynomial operator*(const RationalPolynomial& other) const
+        {
+            return RationalPolynomial(polynomial_detail::karatsuba(m_coefficients, other.m_coefficients, karatsuba_threshold));
+        }
+
+        /// \brief product by a constant
+        RationalPolynomial operator*(const Rational<T>& factor) const
+        {
+            std::vector<Rational<T>> coefficients = m_coefficients;
+            for (Rational<T>& coefficient : coefficients)
+            {
+                coefficient *= factor;
+            }
+            return RationalPolynomial(coefficients);
+        }
+
+        /// \brief quotient of the division, see divide()
+        RationalPolynomial operator/(const RationalPolynomial& divisor) const { return divide(divisor).first; }
+
+        /// \brief remainder of the division, see divide()
+        RationalPolynomial operator%(const RationalPolynomial& divisor) const { return divide(divisor).second; }
+
+        /// \brief add a polynomial to the called polynomial
+        void operator+=(const RationalPolynomial& other) { *this = *this + other; }
+
+        /// \brief substract a polynomial to the called polynomial
+        void operator-=(const RationalPolynomial& other) { *this = *this - other; }
+
+        /// \brief multiply the called polynomial by a polynomial
+        void operator*=(const RationalPolynomial& other) { *this = *this * other; }
+
+        /// \brief equality operator
+        bool operator==(const RationalPolynomial& other) const { return m_coefficients == other.m_coefficients; }
+
+        /// \brief difference operator
+        bool operator!=(const RationalPolynomial& other) const { return !(*this == other); }
+};
+
+/// \brief overload the << operator for RationalPolynomial, highest degree first : 1/2 x^2 - 3/1 x + 1/1
+template<typename T>
+std::ostream& operator<<(std::ostream& stream, const RationalPolynomial<T>& polynomial)
+{
+    if (polynomial.is_zero())
+    {
+        return stream << "0";
+    }
+    for (int i = polynomial.degree(); i >= 0; --i)
+    {
+        Rational<T> coefficient = polynomial[i];
+        if (coefficient.get_numerator() == 0)
+        {
+            continue;
+        }
+        if (i != polynomial.degree())
+        {
+            stream << (coefficient.get_numerator() < 0 ? " - " : " + ");
+            coefficient = coefficient.abs();
+        }
+        stream << coefficient;
+        if (i > 0)
+        {
+            stream << " x" << (i > 1 ? "^" + std::to_string(i) : "");
+        }
+    }
+    return stream;
+}
+
+#endif
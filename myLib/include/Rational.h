@@ -6,6 +6,8 @@
 #include <limits>
 #include <cmath>
 
+#include "RationalStats.h"
+
 // Doxygen menu
 /// \version 0.1
 /// \mainpage
@@ -29,11 +31,33 @@
 /// 	- or [path to build]/INTERFACE/doc/doc-doxygen/html/index.html
 /// \section use_sec How to use
 /// \li A demo is available at /build/myCode/main to explain you how it works
+/// \subsection stats_sec Instrumentation
+/// \li cmake -DRATIONAL_INSTRUMENTATION=ON enables per thread counters (gcd calls, conversion depth, reversals, near overflows, bit lengths)
+/// \li rational_stats::snapshot().dump(std::cout) prints them, see RationalStats.h
+/// \subsection cf_sec Continued fractions
+/// \li ContinuedFraction.h gives lazy streams of partial quotients, exact square roots and Gosper's arithmetic between streams
+/// \subsection modular_sec Multi-modular arithmetic
+/// \li MultiModular.h runs exact computations modulo 63-bit primes in parallel (Montgomery multiplication) and rebuilds Rational results (CRT + Wang's reconstruction)
+/// \subsection geometry_sec Geometry
+/// \li Geometry.h gives Point2 / Point3 with Rational coordinates and exact orient2d, orient3d, incircle and segment intersection (floating point filter first)
+/// \li WideInt.h gives the fixed size integers behind the exact predicates, also used by the polynomial root isolation
+/// \subsection lp_sec Linear programming
+/// \li LinearProgram.h solves max c.x under sparse linear constraints with a simplex pivoting in double, then certifies (or repairs) the final basis with checked exact arithmetic and returns Rational primal and dual values
+/// \subsection farey_sec Farey sequences
+/// \li Farey.h enumerates the Farey sequence of order N lazily (next-term recurrence, no gcd), counts and ranks it without building it, finds Farey neighbors and Stern-Brocot paths, and splits the enumeration into parallel chunks
+/// \subsection transcendental_sec Transcendental functions
+/// \li Transcendental.h computes sin, cos, tan, exp and pi as Rational within a requested absolute error (exact reduction by a 100-bit pi / 2, Taylor series in fixed point, simplest fraction in the error interval), one value or a whole vector at a time
+/// \subsection polynomial_sec Polynomials
+/// \li Polynomial.h gives RationalPolynomial : Horner evaluation (batched on integers), Karatsuba products, division, content, gcd, Lagrange and Newton interpolation, and real roots isolated in disjoint Rational intervals (Descartes' method) refined to a requested width
+/// \subsection bounded_sec Bounded denominators
+/// \li BoundedRational.h gives BoundedRational<T, MaxDen> : every operation rounds its exact result to a fraction of denominator <= MaxDen (nearest, down, up or toward zero) in a fixed number of steps and tracks the accumulated error bound
+/// \subsection build_options_sec Build options
+/// \li Rational<int|long|long long> are explicitly instantiated in the compiled library, RATIONAL_EXTERN_TEMPLATES=ON makes its users link these instead of instantiating them, RATIONAL_MODULE=ON builds the C++20 module interface (import rational;, CMake >= 3.28)
 /// \section credits_sec Credits
 /// \li Thanks to our teacher Vincent Nozick who shared us his knowledge in order to achieve this project
 
-int default_nb_iter = 10;
-float default_error_value = 1e-4;
+inline int default_nb_iter = 10;
+inline float default_error_value = 1e-4;
 
 /// \class Rational
 /// \brief class defining a Rational number for linear algebra operations
@@ -62,7 +86,8 @@ class Rational
 			    throw std::invalid_argument("numerator and denominator can't be equal to 0");
 		    }
 
-            int gcd = get_gcd();
+            T gcd = get_gcd();
+            RATIONAL_STATS_GCD();
             if (gcd != 1)
             {
                 m_numerator /= gcd;
@@ -71,6 +96,7 @@ class Rational
             
             m_numerator *= get_sign(m_denominator);
             m_denominator *= get_sign(m_denominator);
+            RATIONAL_STATS_VALUE(m_numerator, m_denominator);
         }
 
         /// \brief copy constructor
@@ -115,7 +141,7 @@ class Rational
         constexpr inline void set_denominator(T var) { m_denominator = var; };
 
         /// \brief return the greatest common divisor of numerator and denominator
-        constexpr inline int get_gcd() const { return std::gcd(m_numerator, m_denominator); };
+        constexpr inline T get_gcd() const { return std::gcd(m_numerator, m_denominator); };
 
         /// \brief return the float value of the fraction, if denominator equals 0 either return inf or -inf depending on the sign of the numerator
         constexpr float get_value() const
@@ -149,6 +175,7 @@ class Rational
             }
             else if constexpr (std::is_floating_point_v<U>)
             {
+                RATIONAL_STATS_CONVERSION_SCOPE();
                 U real_absolute_value = std::abs(real);
             
                 if (real_absolute_value == 0 || nb_iter == 0)
@@ -178,6 +205,7 @@ class Rational
         /// \brief return the reverse of a fraction (a/b returns b/a), though denominator can't be equal to 0
         constexpr Rational<T> reverse() const
         {
+            RATIONAL_STATS_REVERSAL();
             if (m_denominator == 0)
             {
 				throw std::invalid_argument("denominator can't be equal to 0");
@@ -473,4 +501,50 @@ std::ostream& operator<<(std::ostream& stream, const Rational<T>& ratio)
     return stream;
 }
 
+/// \brief members of Rational<T> taking an operand of type U, listed once for the explicit instantiations of Rational.cpp
+/// and the extern declarations below
+#define RATIONAL_OPERAND_MEMBERS(PREFIX, T, U) \
+    PREFIX Rational<T> Rational<T>::convert_real_to_ratio<U>(const U&, const uint) const; \
+    PREFIX void Rational<T>::operator=<U>(const U&); \
+    PREFIX Rational<T> Rational<T>::operator+<U>(const U&) const; \
+    PREFIX void Rational<T>::operator+=<U>(const U&); \
+    PREFIX Rational<T> Rational<T>::operator-<U>(const U&) const; \
+    PREFIX void Rational<T>::operator-=<U>(const U&); \
+    PREFIX Rational<T> Rational<T>::operator*<U>(const U&) const; \
+    PREFIX void Rational<T>::operator*=<U>(const U&); \
+    PREFIX Rational<T> Rational<T>::operator/<U>(const U&) const; \
+    PREFIX void Rational<T>::operator/=<U>(const U&); \
+    PREFIX bool Rational<T>::operator==<U>(const U&) const; \
+    PREFIX bool Rational<T>::operator!=<U>(const U&) const; \
+    PREFIX bool Rational<T>::operator><U>(const U&) const; \
+    PREFIX bool Rational<T>::operator>=<U>(const U&) const; \
+    PREFIX bool Rational<T>::operator< <U>(const U&) const; \
+    PREFIX bool Rational<T>::operator<=<U>(const U&) const;
+
+/// \brief members of Rational<T> taking a built-in operand of type U (the converting constructor would be ambiguous with the
+/// copy constructor for Rational<T>)
+#define RATIONAL_ARITHMETIC_OPERAND_MEMBERS(PREFIX, T, U) \
+    PREFIX Rational<T>::Rational(const U&); \
+    RATIONAL_OPERAND_MEMBERS(PREFIX, T, U)
+
+/// \brief Rational<T> with the common operand types (int, long, long long, float, double and Rational<T>)
+#define RATIONAL_INSTANTIATIONS(PREFIX, T) \
+    PREFIX class Rational<T>; \
+    PREFIX std::ostream& operator<< <T>(std::ostream&, const Rational<T>&); \
+    RATIONAL_ARITHMETIC_OPERAND_MEMBERS(PREFIX, T, int) \
+    RATIONAL_ARITHMETIC_OPERAND_MEMBERS(PREFIX, T, long) \
+    RATIONAL_ARITHMETIC_OPERAND_MEMBERS(PREFIX, T, long long) \
+    RATIONAL_ARITHMETIC_OPERAND_MEMBERS(PREFIX, T, float) \
+    RATIONAL_ARITHMETIC_OPERAND_MEMBERS(PREFIX, T, double) \
+    RATIONAL_OPERAND_MEMBERS(PREFIX, T, Rational<T>)
+
+// extern template mode : Rational<int|long|long long> are instantiated once in the compiled library instead of in every
+// translation unit, the Rational target defines RATIONAL_EXTERN_TEMPLATES for its users when the option is ON.
+// RATIONAL_INSTRUMENTATION must be the same in the library and in every user (the targets define it PUBLIC)
+#if defined(RATIONAL_EXTERN_TEMPLATES)
+RATIONAL_INSTANTIATIONS(extern template, int)
+RATIONAL_INSTANTIATIONS(extern template, long)
+RATIONAL_INSTANTIATIONS(extern template, long long)
+#endif
+
 #endif
\ No newline at end of file
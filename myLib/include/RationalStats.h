@@ -0,0 +1,334 @@
+#ifndef RationalStats_H
+#define RationalStats_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+#ifdef RATIONAL_INSTRUMENTATION
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+/// \namespace rational_stats
+/// \brief opt-in counters on the Rational hot paths (gcd calls, conversions, reversals, near overflows, bit lengths)
+/// \details compile with RATIONAL_INSTRUMENTATION defined (cmake -DRATIONAL_INSTRUMENTATION=ON) to enable them.
+/// Each thread writes its own counters without any synchronisation, snapshot() sums all of them.
+/// When disabled, the RATIONAL_STATS_* macros expand to nothing and snapshot() always returns zeros.
+namespace rational_stats
+{
+    constexpr int max_depth = 63; /**< last bucket of the conversion depth histogram, deeper conversions are counted in it */
+    constexpr int max_bits = 64; /**< last bucket of the bit length histograms */
+    constexpr int near_overflow_margin = 2; /**< a value is near overflow when it uses more than digits - margin bits */
+
+    /// \struct Snapshot
+    /// \brief aggregated value of the counters at a given time
+    struct Snapshot
+    {
+        uint64_t gcd_calls = 0; /**< number of gcd computed to normalize a fraction */
+        uint64_t conversions = 0; /**< number of top level convert_real_to_ratio calls on floating point values */
+        uint64_t conversion_steps = 0; /**< number of recursive convert_real_to_ratio calls, top level ones included */
+        uint64_t reversals = 0; /**< number of reverse() calls */
+        uint64_t near_overflows = 0; /**< number of fractions whose numerator or denominator is close to the limit of its type */
+        std::array<uint64_t, max_depth + 1> conversion_depth = {}; /**< histogram of the recursion depth of the conversions */
+        std::array<uint64_t, max_bits + 1> numerator_bits = {}; /**< histogram of the bit length of the normalized numerators */
+        std::array<uint64_t, max_bits + 1> denominator_bits = {}; /**< histogram of the bit length of the normalized denominators */
+
+        /// \brief add the counters of another snapshot
+        Snapshot& operator+=(const Snapshot& other)
+        {
+            gcd_calls += other.gcd_calls;
+            conversions += other.conversions;
+            conversion_steps += other.conversion_steps;
+            reversals += other.reversals;
+            near_overflows += other.near_overflows;
+            for (int i = 0; i <= max_depth; ++i)
+            {
+                conversion_depth[i] += other.conversion_depth[i];
+            }
+            for (int i = 0; i <= max_bits; ++i)
+            {
+                numerator_bits[i] += other.numerator_bits[i];
+                denominator_bits[i] += other.denominator_bits[i];
+            }
+            return *this;
+        }
+
+        /// \brief write the counters, one per line as "name value", histograms as "name bucket:count ..." (empty buckets skipped)
+        /// \param stream : where to write
+        void dump(std::ostream& stream) const
+        {
+            stream << "gcd_calls " << gcd_calls << "\n";
+            stream << "conversions " << conversions << "\n";
+            stream << "conversion_steps " << conversion_steps << "\n";
+            stream << "reversals " << reversals << "\n";
+            stream << "near_overflows " << near_overflows << "\n";
+            dump_histogram(stream, "conversion_depth", conversion_depth.data(), max_depth + 1);
+            dump_histogram(stream, "numerator_bits", numerator_bits.data(), max_bits + 1);
+            dump_histogram(stream, "denominator_bits", denominator_bits.data(), max_bits + 1);
+        }
+
+    private:
+        static void dump_histogram(std::ostream& stream, const char* name, const uint64_t* buckets, int size)
+        {
+            stream << name;
+            for (int i = 0; i < size; ++i)
+            {
+                if (buckets[i] != 0)
+                {
+                    stream << " " << i << ":" << buckets[i];
+                }
+            }
+            stream << "\n";
+        }
+    };
+
+    /// \brief return the number of bits needed to write the absolute value of an integer (0 for 0)
+    /// \tparam T : int
+    /// \param val : the integer
+    template<typename T>
+    constexpr int bit_length(T val)
+    {
+        using U = std::make_unsigned_t<T>;
+        U magnitude = (val < 0 ? U(0) - U(val) : U(val));
+        int bits = 0;
+        for (; magnitude != 0; magnitude >>= 1)
+        {
+            ++bits;
+        }
+        return bits;
+    }
+
+#ifdef RATIONAL_INSTRUMENTATION
+
+    constexpr bool enabled = true;
+
+    /// \brief counter written by a single thread and read by any : relaxed load/store, no read-modify-write instruction
+    struct Counter
+    {
+        std::atomic<uint64_t> value{0};
+
+        void increment() { value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+        uint64_t get() const { return value.load(std::memory_order_relaxed); }
+        void reset() { value.store(0, std::memory_order_relaxed); }
+    };
+
+    /// \struct ThreadCounters
+    /// \brief counters of one thread, registered while the thread lives
+    struct ThreadCounters
+    {
+        Counter gcd_calls;
+        Counter conversions;
+        Counter conversion_steps;
+        Counter reversals;
+        Counter near_overflows;
+        std::array<Counter, max_depth + 1> conversion_depth;
+        std::array<Counter, max_bits + 1> numerator_bits;
+        std::array<Counter, max_bits + 1> denominator_bits;
+        int current_depth = 0; /**< depth of the conversion running on this thread */
+        int deepest = 0; /**< deepest level reached by the conversion running on this thread */
+
+        ThreadCounters();
+        ~ThreadCounters();
+
+        /// \brief return the current value of the counters
+        Snapshot read() const
+        {
+            Snapshot snapshot;
+            snapshot.gcd_calls = gcd_calls.get();
+            snapshot.conversions = conversions.get();
+            snapshot.conversion_steps = conversion_steps.get();
+            snapshot.reversals = reversals.get();
+            snapshot.near_overflows = near_overflows.get();
+            for (int i = 0; i <= max_depth; ++i)
+            {
+                snapshot.conversion_depth[i] = conversion_depth[i].get();
+            }
+            for (int i = 0; i <= max_bits; ++i)
+            {
+                snapshot.numerator_bits[i] = numerator_bits[i].get();
+                snapshot.denominator_bits[i] = denominator_bits[i].get();
+            }
+            return snapshot;
+        }
+
+        /// \brief set all the counters to 0
+        void reset()
+        {
+            gcd_calls.reset();
+            conversions.reset();
+            conversion_steps.reset();
+            reversals.reset();
+            near_overflows.reset();
+            for (Counter& counter : conversion_depth) { counter.reset(); }
+            for (Counter& counter : numerator_bits) { counter.reset(); }
+            for (Counter& counter : denominator_bits) { counter.reset(); }
+        }
+    };
+
+    /// \struct Registry
+    /// \brief list of the living threads counters, and sum of the counters of the threads that exited
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<ThreadCounters*> threads;
+        Snapshot retired;
+    };
+
+    /// \brief return the process wide registry
+    inline Registry& registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    inline ThreadCounters::ThreadCounters()
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(this);
+    }
+
+    inline ThreadCounters::~ThreadCounters()
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.retired += read();
+        for (size_t i = 0; i < r.threads.size(); ++i)
+        {
+            if (r.threads[i] == this)
+            {
+                r.threads[i] = r.threads.back();
+                r.threads.pop_back();
+                break;
+            }
+        }
+    }
+
+    /// \brief return the counters of the calling thread
+    inline ThreadCounters& local()
+    {
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    /// \brief return the sum of the counters of every thread, including the ones that already exited
+    inline Snapshot snapshot()
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        Snapshot total = r.retired;
+        for (const ThreadCounters* counters : r.threads)
+        {
+            total += counters->read();
+        }
+        return total;
+    }
+
+    /// \brief set the counters of every thread to 0
+    /// \details the increments are a relaxed load then a store, not a read-modify-write : an increment running on another
+    /// thread during reset() can write back its old value and lose the reset. Call it while no other thread is counting
+    inline void reset()
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.retired = Snapshot();
+        for (ThreadCounters* counters : r.threads)
+        {
+            counters->reset();
+        }
+    }
+
+    /// \brief count a gcd call
+    inline void record_gcd()
+    {
+        local().gcd_calls.increment();
+    }
+
+    /// \brief count a reverse call
+    inline void record_reversal()
+    {
+        local().reversals.increment();
+    }
+
+    /// \brief record the bit length of a normalized fraction and whether it is near overflow
+    /// \tparam T : int
+    /// \param numerator : numerator
+    /// \param denominator : denominator
+    template<typename T>
+    inline void record_value(T numerator, T denominator)
+    {
+        ThreadCounters& counters = local();
+        int numerator_bits = bit_length(numerator);
+        int denominator_bits = bit_length(denominator);
+        counters.numerator_bits[numerator_bits < max_bits ? numerator_bits : max_bits].increment();
+        counters.denominator_bits[denominator_bits < max_bits ? denominator_bits : max_bits].increment();
+        constexpr int limit = std::numeric_limits<T>::digits - near_overflow_margin;
+        if (numerator_bits > limit || denominator_bits > limit)
+        {
+            counters.near_overflows.increment();
+        }
+    }
+
+    /// \class ConversionScope
+    /// \brief put at the beginning of each recursive conversion step, records the depth when the top level call returns
+    class ConversionScope
+    {
+        public:
+            ConversionScope() : m_counters(local())
+            {
+                m_counters.conversion_steps.increment();
+                ++m_counters.current_depth;
+                if (m_counters.current_depth > m_counters.deepest)
+                {
+                    m_counters.deepest = m_counters.current_depth;
+                }
+            }
+
+            ~ConversionScope()
+            {
+                if (--m_counters.current_depth == 0)
+                {
+                    int depth = m_counters.deepest - 1;
+                    m_counters.conversion_depth[depth < max_depth ? depth : max_depth].increment();
+                    m_counters.conversions.increment();
+                    m_counters.deepest = 0;
+                }
+            }
+
+            ConversionScope(const ConversionScope&) = delete;
+            ConversionScope& operator=(const ConversionScope&) = delete;
+
+        private:
+            ThreadCounters& m_counters; /**< counters of the calling thread */
+    };
+
+    // the counters are skipped during constant evaluation, so the constexpr members of Rational stay constexpr
+    #define RATIONAL_STATS_GCD() (__builtin_is_constant_evaluated() ? (void)0 : ::rational_stats::record_gcd())
+    #define RATIONAL_STATS_REVERSAL() (__builtin_is_constant_evaluated() ? (void)0 : ::rational_stats::record_reversal())
+    #define RATIONAL_STATS_VALUE(numerator, denominator) \
+        (__builtin_is_constant_evaluated() ? (void)0 : ::rational_stats::record_value(numerator, denominator))
+    #define RATIONAL_STATS_CONVERSION_SCOPE() ::rational_stats::ConversionScope rational_stats_conversion_scope
+
+#else
+
+    constexpr bool enabled = false;
+
+    /// \brief instrumentation disabled, always return zeros
+    inline Snapshot snapshot() { return Snapshot(); }
+
+    /// \brief instrumentation disabled, does nothing
+    inline void reset() {}
+
+    #define RATIONAL_STATS_GCD() ((void)0)
+    #define RATIONAL_STATS_REVERSAL() ((void)0)
+    #define RATIONAL_STATS_VALUE(numerator, denominator) ((void)0)
+    #define RATIONAL_STATS_CONVERSION_SCOPE() ((void)0)
+
+#endif
+}
+
+#endif
@@ -0,0 +1,413 @@
+#ifndef Transcendental_H
+#define Transcendental_H
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Rational.h"
+
+/// \namespace transcendental_detail
+/// \brief signed dyadic fixed point on 128 bits : a value v stands for v / 2^bits
+namespace transcendental_detail
+{
+    using Wide = __int128;
+
+    constexpr int working_bits = 60; /**< fractional bits of the series evaluation */
+    constexpr int reduction_bits = 100; /**< fractional bits of the argument reduction */
+    constexpr int max_reduced_argument_log2 = 24; /**< |x| must be <= 2^24 */
+
+    /// \brief floor(pi/2 * 2^100) : pi/2 is in [half_pi, half_pi + 1] / 2^100
+    inline Wide half_pi_100() { return (Wide(0x1921fb5444LL) << 64) | Wide(0x2d18469898cc5170ULL); }
+
+    /// \brief floor(ln(2) * 2^100) : ln(2) is in [ln2, ln2 + 1] / 2^100
+    inline Wide ln2_100() { return (Wide(0xb17217f7dLL) << 64) | Wide(0x1cf79abc9e3b3980ULL); }
+
+    /// \brief floor(a b / 2^working_bits), |a| and |b| must be < 2^(working_bits + 3)
+    inline Wide mul(const Wide& a, const Wide& b) { return (a * b) >> working_bits; }
+
+    /// \brief floor(num * 2^bits / den) for den > 0, without overflow as long as the result fits (two steps of bits / 2)
+    template<typename T>
+    Wide to_fixed(const T& num, const T& den, const int bits)
+    {
+        Wide n = num;
+        Wide d = den;
+        Wide q = n / d;
+        Wide r = n % d;
+        if (r < 0)
+        {
+            --q;
+            r += d;
+        }
+        const int half = bits / 2;
+        Wide high = (r << half) / d;
+        Wide r2 = (r << half) % d;
+        Wide low = (r2 << (bits - half)) / d;
+        return q * (Wide(1) << bits) + (high << (bits - half)) + low;
+    }
+
+    /// \brief floor(a / b) for b > 0
+    inline Wide floor_div(const Wide& a, const Wide& b)
+    {
+        Wide q = a / b;
+        return (a % b != 0 && a < 0 ? q - 1 : q);
+    }
+
+    /// \brief the fraction with the smallest denominator in [a/b, c/d], 0 < a/b <= c/d (Stern-Brocot, by continued fractions)
+    inline std::pair<Wide, Wide> simplest_positive(Wide a, Wide b, Wide c, Wide d)
+    {
+        // p/q = h_k / k_k convergents of the common prefix of the two continued fractions
+        Wide p = 1, q = 0, p_prev = 0, q_prev = 1;
+        while (true)
+        {
+            Wide integer = floor_div(a, b);
+            if (integer * b == a)
+            {
+                return {integer * p + p_prev, integer * q + q_prev};
+            }
+            if (integer < floor_div(c, d))
+            {
+                return {(integer + 1) * p + p_prev, (integer + 1) * q + q_prev};
+            }
+            Wide p_next = integer * p + p_prev;
+            Wide q_next = integer * q + q_prev;
+            p_prev = p;
+            q_prev = q;
+            p = p_next;
+            q = q_next;
+            // 1 / (c/d - integer) <= 1 / (x - integer) <= 1 / (a/b - integer)
+            Wide a_next = d, b_next = c - integer * d;
+            Wide c_next = b, d_next = a - integer * b;
+            a = a_next;
+            b = b_next;
+            c = c_next;
+            d = d_next;
+        }
+    }
+
+    /// \brief the fraction with the smallest denominator in [low, high] / 2^working_bits
+    inline std::pair<Wide, Wide> simplest(const Wide& low, const Wide& high)
+    {
+        const Wide one = Wide(1) << working_bits;
+        if (low <= 0 && high >= 0)
+        {
+            return {0, 1};
+        }
+        if (high < 0)
+        {
+            std::pair<Wide, Wide> opposite = simplest_positive(-high, one, -low, one);
+            return {-opposite.first, opposite.second};
+        }
+        return simplest_positive(low, one, high, one);
+    }
+}
+
+/// \class Transcendental
+/// \brief sin, cos, tan and exp of a Rational as a Rational within a given error bound
+/// \details the argument is reduced with exact rational brackets of pi/2 and ln(2) (100 bits), the Taylor polynomial is evaluated
+/// by Horner's rule in 60 bits dyadic fixed point (a bounded denominator 2^60) with a tracked error bound, and the result is the
+/// fraction with the smallest denominator within the error bound of the true value. The coefficients only depend on the
+/// error bound, so one kernel is shared by every value of a batch.
+/// \tparam T : int, long long is advised
+template<typename T = long long>
+class Transcendental
+{
+    public:
+        using Wide = transcendental_detail::Wide;
+
+        //constructors
+
+        /// \brief kernels for an error bound
+        /// \tparam T : int
+        /// \param epsilon : |result - f(x)| <= epsilon, in [2^-50, 1], throws std::invalid_argument otherwise
+        explicit Transcendental(const Rational<T>& epsilon) : m_epsilon(epsilon)
+        {
+            using namespace transcendental_detail;
+            if (epsilon <= 0 || epsilon > 1)
+            {
+                throw std::invalid_argument("error bound must be in ]0, 1]");
+            }
+            m_epsilon_fixed = to_fixed(epsilon.get_numerator(), epsilon.get_denominator(), working_bits);
+            if (m_epsilon_fixed < (Wide(1) << (working_bits - 50)))
+            {
+                throw std::invalid_argument("error bound must be >= 2^-50");
+            }
+            // 1/k! rounded down down to 0, floor(floor(x) / k) = floor(x / k) so every coefficient is within 1 ulp
+            const Wide one = Wide(1) << working_bits;
+            m_inverse_factorials.push_back(one);
+            while (m_inverse_factorials.back() != 0)
+            {
+                m_inverse_factorials.push_back(m_inverse_factorials.back() / Wide(m_inverse_factorials.size()));
+            }
+            // sin, cos and exp stop at the first coefficient under epsilon / 8
+            while (m_inverse_factorials[m_degree] * 8 > m_epsilon_fixed)
+            {
+                ++m_degree;
+            }
+        }
+
+    private:
+        Rational<T> m_epsilon; /**< error bound */
+        Wide m_epsilon_fixed; /**< error bound in fixed point, rounded down */
+        std::vector<Wide> m_inverse_factorials; /**< shared series coefficients 1/k! in fixed point, down to 0 */
+        size_t m_degree = 0; /**< degree of the polynomials of sin, cos and exp for the error bound */
+
+    public:
+        //Functions
+
+        /// \brief return the error bound
+        const Rational<T>& error_bound() const { return m_epsilon; }
+
+        /// \brief return the degree of the Taylor polynomials of sin, cos and exp for the error bound (tan uses the working precision)
+        size_t degree() const { return m_degree; }
+
+        /// \brief return a Rational within the error bound of pi, from its exact bracket
+        Rational<T> pi() const
+        {
+            using namespace transcendental_detail;
+            Wide pi_fixed = (half_pi_100() * 2) >> (reduction_bits - working_bits);
+            // pi is in [pi_fixed, pi_fixed + 1] ulps
+            return result(pi_fixed, 1);
+        }
+
+        /// \brief return sin(x) within the error bound
+        /// \param x : |x| <= 2^24, throws std::invalid_argument otherwise
+        Rational<T> sin(const Rational<T>& x) const
+        {
+            Reduced r = reduce_half_pi(x);
+            Wide value, error;
+            quadrant(r, (r.k & 1) ? false : true, m_degree, value, error);
+            return result((r.k & 2) ? -value : value, error);
+        }
+
+        /// \brief return cos(x) within the error bound
+        /// \param x : |x| <= 2^24, throws std::invalid_argument otherwise
+        Rational<T> cos(const Rational<T>& x) const
+        {
+            Reduced r = reduce_half_pi(x);
+            Wide value, error;
+            quadrant(r, (r.k & 1) ? true : false, m_degree, value, error);
+            // cos(r + k pi/2) : cos r, -sin r, -cos r, sin r
+            bool negative = ((r.k + 1) & 2) != 0;
+            return result(negative ? -value : value, error);
+        }
+
+        /// \brief return tan(x) within the error bound
+        /// \param x : |x| <= 2^24, throws std::invalid_argument otherwise, and std::overflow_error too close to a pole
+        Rational<T> tan(const Rational<T>& x) const
+        {
+            using namespace transcendental_detail;
+            Reduced r = reduce_half_pi(x);
+            Wide s, es, c, ec;
+            // full working precision : the division amplifies the errors of sin and cos
+            quadrant(r, true, m_inverse_factorials.size() - 2, s, es);
+            quadrant(r, false, m_inverse_factorials.size() - 2, c, ec);
+            // tan(r + k pi/2) : s / c for an even k, -c / s for an odd one
+            Wide num = ((r.k & 1) ? -c : s), e_num = ((r.k & 1) ? ec : es);
+            Wide den = ((r.k & 1) ? s : c), e_den = ((r.k & 1) ? es : ec);
+            if (den < 0)
+            {
+                num = -num;
+                den = -den;
+            }
+            if (den - e_den <= 0 || (num < 0 ? -num : num) >= (den << 40))
+            {
+                throw std::overflow_error("tan is too close to a pole");
+            }
+            // |N/D - n/d| <= (e_n + |n/d| e_d) / (d - e_d), bounded in long double (64 bits mantissa) with a safety margin
+            Wide quotient = floor_div(num * (Wide(1) << working_bits), den);
+            long double magnitude = (long double)(quotient < 0 ? -quotient : quotient);
+            long double bound = ((long double)e_num * (long double)(Wide(1) << working_bits) + magnitude * (long double)e_den) / (long double)(den - e_den);
+            if (bound > 1e30L)
+            {
+                throw std::invalid_argument("error bound too small for the magnitude of the result");
+            }
+            Wide error = Wide(bound * (1 + 1e-15L)) + 2;
+            return result(quotient, error);
+        }
+
+        /// \brief return exp(x) within the error bound
+        /// \param x : |x| <= 2^24, throws std::invalid_argument otherwise, and std::overflow_error if exp(x) doesn't fit in T
+        Rational<T> exp(const Rational<T>& x) const
+        {
+            using namespace transcendental_detail;
+            check_argument(x);
+            Wide x_fixed = to_fixed(x.get_numerator(), x.get_denominator(), reduction_bits);
+            // x = n ln(2) + r, r in about [0, ln(2)[
+            long long n = (long long)std::floor(to_double(x) / 0.69314718055994530942);
+            Wide r = (x_fixed - Wide(n) * ln2_100()) >> (reduction_bits - working_bits);
+            if (n > 62)
+            {
+                throw std::overflow_error("exp doesn't fit in the type");
+            }
+            // the result is scaled by 2^n, so is the remainder : more terms for a large n
+            size_t degree = m_degree;
+            while (n > 0 && degree + 2 < m_inverse_factorials.size() && (m_inverse_factorials[degree] << n) * 8 > m_epsilon_fixed)
+            {
+                ++degree;
+            }
+            // Horner : sum r^k / k!, each step 1 ulp of rounding and 1 of coefficient, |r| < 1 doesn't amplify them
+            Wide value = m_inverse_factorials[degree];
+            for (size_t k = degree; k-- > 0;)
+            {
+                value = m_inverse_factorials[k] + mul(r, value);
+            }
+            // rounding, the reduction error (2 ulps times exp(r) <= 2) and the remainder (<= 2 / (degree + 1)!)
+            Wide error = 2 * Wide(degree + 1) + 4 + 2 * (m_inverse_factorials[degree + 1] + 1);
+            if (n >= 0)
+            {
+                value <<= n;
+                error <<= n;
+            }
+            else if (n > -120)
+            {
+                value >>= -n;
+                error = (error >> -n) + 1;
+            }
+            else
+            {
+                value = 0;
+                error = 1;
+            }
+            return result(value, error);
+        }
+
+        /// \brief batch sin, the coefficients are shared by every value
+        std::vector<Rational<T>> sin(const std::vector<Rational<T>>& xs) const { return apply(xs, &Transcendental::sin); }
+
+        /// \brief batch cos, the coefficients are shared by every value
+        std::vector<Rational<T>> cos(const std::vector<Rational<T>>& xs) const { return apply(xs, &Transcendental::cos); }
+
+        /// \brief batch tan, the coefficients are shared by every value
+        std::vector<Rational<T>> tan(const std::vector<Rational<T>>& xs) const { return apply(xs, &Transcendental::tan); }
+
+        /// \brief batch exp, the coefficients are shared by every value
+        std::vector<Rational<T>> exp(const std::vector<Rational<T>>& xs) const { return apply(xs, &Transcendental::exp); }
+
+    private:
+        /// \struct Reduced
+        /// \brief x = k pi/2 + r
+        struct Reduced
+        {
+            long long k; /**< quadrant */
+            Wide r; /**< remainder, |r| <= about pi/4, within 2 ulps */
+        };
+
+        static double to_double(const Rational<T>& x)
+        {
+            return double(x.get_numerator()) / double(x.get_denominator());
+        }
+
+        /// \brief throws std::invalid_argument if |x| > 2^24, compared on Wide since den * 2^24 can overflow T
+        static void check_argument(const Rational<T>& x)
+        {
+            using namespace transcendental_detail;
+            const Wide numerator = x.get_numerator();
+            if ((numerator < 0 ? -numerator : numerator) > (Wide(x.get_denominator()) << max_reduced_argument_log2))
+            {
+                throw std::invalid_argument("|x| must be <= 2^24");
+            }
+        }
+
+        /// \brief reduction with the exact pi/2 bracket : k pi/2 is off by at most |k| / 2^100, under 1 ulp of the result
+        Reduced reduce_half_pi(const Rational<T>& x) const
+        {
+            using namespace transcendental_detail;
+            check_argument(x);
+            Wide x_fixed = to_fixed(x.get_numerator(), x.get_denominator(), reduction_bits);
+            long long k = std::llround(to_double(x) / 1.57079632679489661923);
+            Wide r = (x_fixed - Wide(k) * half_pi_100()) >> (reduction_bits - working_bits);
+            return {k, r};
+        }
+
+        /// \brief sin(r) or cos(r) and its error bound in ulps, with the terms up to the given degree
+        void quadrant(const Reduced& reduced, const bool sine, const size_t degree, Wide& value, Wide& error) const
+        {
+            using namespace transcendental_detail;
+            Wide u = mul(reduced.r, reduced.r);
+            // odd coefficients for sin(r) / r, even ones for cos(r), alternating, by Horner's rule in u = r^2
+            size_t k = (degree % 2 == (sine ? 1 : 0) ? degree : degree - 1);
+            const size_t omitted = k + 2;
+            value = m_inverse_factorials[k];
+            Wide nb_steps = 1;
+            while (k >= 2)
+            {
+                k -= 2;
+                value = m_inverse_factorials[k] - mul(u, value);
+                ++nb_steps;
+            }
+            if (sine)
+            {
+                value = mul(reduced.r, value);
+            }
+            // 2 ulps per Horner step (rounding and coefficient), u off by 5 ulps, r by 2, and the remainder of the alternating
+            // series, under its first omitted term
+            Wide remainder = (omitted < m_inverse_factorials.size() ? m_inverse_factorials[omitted] : 0) + 1;
+            error = 2 * nb_steps + 12 + remainder;
+        }
+
+        /// \brief the fraction with the smallest denominator within epsilon of every value of [value - error, value + error]
+        Rational<T> result(const Wide& value, const Wide& error) const
+        {
+            if (2 * error >= m_epsilon_fixed)
+            {
+                throw std::invalid_argument("error bound too small for the magnitude of the result");
+            }
+            std::pair<Wide, Wide> fraction = transcendental_detail::simplest(value + error - m_epsilon_fixed, value - error + m_epsilon_fixed);
+            if (fraction.first > std::numeric_limits<T>::max() || fraction.first < std::numeric_limits<T>::min() || fraction.second > std::numeric_limits<T>::max())
+            {
+                throw std::overflow_error("result doesn't fit in the type");
+            }
+            Rational<T> ratio;
+            ratio.set_numerator(T(fraction.first));
+            ratio.set_denominator(T(fraction.second));
+            return ratio;
+        }
+
+        std::vector<Rational<T>> apply(const std::vector<Rational<T>>& xs, Rational<T> (Transcendental::*function)(const Rational<T>&) const) const
+        {
+            std::vector<Rational<T>> results;
+            results.reserve(xs.size());
+            for (const Rational<T>& x : xs)
+            {
+                results.push_back((this->*function)(x));
+            }
+            return results;
+        }
+};
+
+/// \brief sin(x) within epsilon
+/// \tparam T : int
+template<typename T>
+Rational<T> rational_sin(const Rational<T>& x, const Rational<T>& epsilon)
+{
+    return Transcendental<T>(epsilon).sin(x);
+}
+
+/// \brief cos(x) within epsilon
+/// \tparam T : int
+template<typename T>
+Rational<T> rational_cos(const Rational<T>& x, const Rational<T>& epsilon)
+{
+    return Transcendental<T>(epsilon).cos(x);
+}
+
+/// \brief tan(x) within epsilon
+/// \tparam T : int
+template<typename T>
+Rational<T> rational_tan(const Rational<T>& x, const Rational<T>& epsilon)
+{
+    return Transcendental<T>(epsilon).tan(x);
+}
+
+/// \brief exp(x) within epsilon
+/// \tparam T : int
+template<typename T>
+Rational<T> rational_exp(const Rational<T>& x, const Rational<T>& epsilon)
+{
+    return Transcendental<T>(epsilon).exp(x);
+}
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef WideInt_H
+#define WideInt_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+/// \class WideInt
+/// \brief fixed size signed integer (two's complement on N 64-bit limbs), only what exact predicates need : +, -, *, sign,
+/// and the comparisons, shifts and truncated division that reduce an exact result
+/// \details N is chosen by the caller so that no result overflows, there is no overflow check
+/// \tparam N : number of 64-bit limbs
+template<size_t N>
+class WideInt
+{
+    public:
+        /// \brief default constructor with value of 0
+        constexpr WideInt() : m_limbs{} {}
+
+        /// \brief value constructor from a native integer
+        /// \param value : the value
+        constexpr WideInt(const long long& value) : m_limbs{}
+        {
+            m_limbs[0] = uint64_t(value);
+            for (size_t i = 1; i < N; ++i)
+            {
+                m_limbs[i] = (value < 0 ? ~uint64_t(0) : 0);
+            }
+        }
+
+    private:
+        std::array<uint64_t, N> m_limbs; /**< little endian limbs */
+
+        bool is_negative() const { return (m_limbs[N - 1] >> 63) != 0; }
+
+    public:
+        /// \brief return -1, 0 or 1
+        int sign() const
+        {
+            if (is_negative())
+            {
+                return -1;
+            }
+            for (uint64_t limb : m_limbs)
+            {
+                if (limb != 0)
+                {
+                    return 1;
+                }
+            }
+            return 0;
+        }
+
+        /// \brief unary minus operator
+        WideInt operator-() const
+        {
+            WideInt result;
+            unsigned __int128 carry = 1;
+            for (size_t i = 0; i < N; ++i)
+            {
+                carry += ~m_limbs[i];
+                result.m_limbs[i] = uint64_t(carry);
+                carry >>= 64;
+            }
+            return result;
+        }
+
+        /// \brief sum of 2 WideInt
+        WideInt operator+(const WideInt& other) const
+        {
+            WideInt result;
+            unsigned __int128 carry = 0;
+            for (size_t i = 0; i < N; ++i)
+            {
+                carry += (unsigned __int128)(m_limbs[i]) + other.m_limbs[i];
+                result.m_limbs[i] = uint64_t(carry);
+                carry >>= 64;
+            }
+            return result;
+        }
+
+        /// \brief subtraction of 2 WideInt
+        WideInt operator-(const WideInt& other) const
+        {
+            return *this + (-other);
+        }
+
+        /// \brief multiplication of 2 WideInt (schoolbook on the magnitudes)
+        WideInt operator*(const WideInt& other) const
+        {
+            bool negative = is_negative() != other.is_negative();
+            const WideInt a = (is_negative() ? -*this : *this);
+            const WideInt b = (other.is_negative() ? -other : other);
+            WideInt result;
+            for (size_t i = 0; i < N; ++i)
+            {
+                if (a.m_limbs[i] == 0)
+                {
+                    continue;
+                }
+                unsigned __int128 carry = 0;
+                for (size_t j = 0; i + j < N; ++j)
+                {
+                    carry += (unsigned __int128)(a.m_limbs[i]) * b.m_limbs[j] + result.m_limbs[i + j];
+                    result.m_limbs[i + j] = uint64_t(carry);
+                    carry >>= 64;
+                }
+            }
+            return (negative ? -result : result);
+        }
+
+        /// \brief equality operator
+        bool operator==(const WideInt& other) const { return m_limbs == other.m_limbs; }
+
+        /// \brief difference operator
+        bool operator!=(const WideInt& other) const { return m_limbs != other.m_limbs; }
+
+        /// \brief signed comparison
+        bool operator<(const WideInt& other) const
+        {
+            if (is_negative() != other.is_negative())
+            {
+                return is_negative();
+            }
+            // same sign : two's complement limbs compare like unsigned ones
+            for (size_t i = N; i-- > 0;)
+            {
+                if (m_limbs[i] != other.m_limbs[i])
+                {
+                    return m_limbs[i] < other.m_limbs[i];
+                }
+            }
+            return false;
+        }
+
+        /// \brief left shift by `bits` (multiplication by 2^bits)
+        WideInt operator<<(const size_t bits) const
+        {
+            WideInt result;
+            const size_t limbs = bits / 64, rest = bits % 64;
+            for (size_t i = N; i-- > limbs;)
+            {
+                result.m_limbs[i] = m_limbs[i - limbs] << rest;
+                if (rest != 0 && i > limbs)
+                {
+                    result.m_limbs[i] |= m_limbs[i - limbs - 1] >> (64 - rest);
+                }
+            }
+            return result;
+        }
+
+        /// \brief arithmetic right shift by `bits` (floor of the division by 2^bits)
+        WideInt operator>>(const size_t bits) const
+        {
+            const uint64_t fill = (is_negative() ? ~uint64_t(0) : 0);
+            WideInt result;
+            const size_t limbs = bits / 64, rest = bits % 64;
+            for (size_t i = 0; i < N; ++i)
+            {
+                uint64_t low = (i + limbs < N ? m_limbs[i + limbs] : fill);
+                uint64_t high = (i + limbs + 1 < N ? m_limbs[i + limbs + 1] : fill);
+                result.m_limbs[i] = (rest == 0 ? low : (low >> rest) | (high << (64 - rest)));
+            }
+            return result;
+        }
+
+        /// \brief number of bits of the magnitude
+        size_t bit_length() const
+        {
+            const WideInt magnitude = (is_negative() ? -*this : *this);
+            for (size_t i = N; i-- > 0;)
+            {
+                if (magnitude.m_limbs[i] != 0)
+                {
+                    return i * 64 + 64 - size_t(__builtin_clzll(magnitude.m_limbs[i]));
+                }
+            }
+            return 0;
+        }
+
+        /// \brief closest long double (up to 2 roundings)
+        long double to_long_double() const
+        {
+            const WideInt magnitude = (is_negative() ? -*this : *this);
+            long double value = 0;
+            for (size_t i = N; i-- > 0;)
+            {
+                value = value * 18446744073709551616.0L + (long double)(magnitude.m_limbs[i]);
+            }
+            return (is_negative() ? -value : value);
+        }
+
+        /// \brief return true if the value is even
+        bool is_even() const { return (m_limbs[0] & 1) == 0; }
+
+        /// \brief quotient of the division truncated toward 0 (bit by bit long division of the magnitudes), other can't be 0
+        WideInt operator/(const WideInt& other) const
+        {
+            if (other.sign() == 0)
+            {
+                throw std::invalid_argument("division by 0");
+            }
+            bool negative = is_negative() != other.is_negative();
+            const WideInt a = (is_negative() ? -*this : *this);
+            const WideInt b = (other.is_negative() ? -other : other);
+            WideInt quotient, remainder;
+            size_t top = N;
+            while (top > 0 && a.m_limbs[top - 1] == 0)
+            {
+                --top;
+            }
+            for (size_t i = top * 64; i-- > 0;)
+            {
+                remainder = remainder << 1;
+                remainder.m_limbs[0] |= (a.m_limbs[i / 64] >> (i % 64)) & 1;
+                if (!(remainder < b))
+                {
+                    remainder = remainder - b;
+                    quotient.m_limbs[i / 64] |= uint64_t(1) << (i % 64);
+                }
+            }
+            return (negative ? -quotient : quotient);
+        }
+
+        /// \brief return the value as a long long, throws std::overflow_error if it doesn't fit
+        long long to_long_long() const
+        {
+            const uint64_t fill = (is_negative() ? ~uint64_t(0) : 0);
+            for (size_t i = 1; i < N; ++i)
+            {
+                if (m_limbs[i] != fill)
+                {
+                    throw std::overflow_error("integer overflow");
+                }
+            }
+            if (((m_limbs[0] >> 63) != 0) != is_negative())
+            {
+                throw std::overflow_error("integer overflow");
+            }
+            return (long long)(m_limbs[0]);
+        }
+};
+
+/// \namespace wide_detail
+/// \brief conversions and gcd on WideInt, shared by the exact geometric predicates and the polynomial root isolation
+namespace wide_detail
+{
+    /// \brief WideInt from a native integer
+    template<size_t N, typename T>
+    WideInt<N> wide(const T& value)
+    {
+        return WideInt<N>((long long)(value));
+    }
+
+    /// \brief greatest common divisor of |a| and |b| (binary algorithm : shifts and subtractions only)
+    template<size_t N>
+    WideInt<N> gcd(WideInt<N> a, WideInt<N> b)
+    {
+        a = (a.sign() < 0 ? -a : a);
+        b = (b.sign() < 0 ? -b : b);
+        if (a.sign() == 0 || b.sign() == 0)
+        {
+            return a + b;
+        }
+        size_t shift = 0;
+        for (; a.is_even() && b.is_even(); ++shift)
+        {
+            a = a >> 1;
+            b = b >> 1;
+        }
+        while (a.is_even())
+        {
+            a = a >> 1;
+        }
+        while (b.sign() != 0)
+        {
+            while (b.is_even())
+            {
+                b = b >> 1;
+            }
+            if (b < a)
+            {
+                std::swap(a, b);
+            }
+            b = b - a;
+        }
+        return a << shift;
+    }
+}
+
+#endif
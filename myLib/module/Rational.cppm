@@ -0,0 +1,12 @@
+// C++20 module interface of the Rational library, built by the RationalModule target when RATIONAL_MODULE is ON
+// usage : import rational;
+module;
+
+#include "Rational.h"
+
+export module rational;
+
+export using ::Rational;
+export using ::operator<<;
+export using ::default_nb_iter;
+export using ::default_error_value;
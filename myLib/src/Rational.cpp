@@ -1 +1,6 @@
-#include "../include/Rational.h"
\ No newline at end of file
+#include "../include/Rational.h"
+
+// explicit instantiations, used by every translation unit compiled with RATIONAL_EXTERN_TEMPLATES
+RATIONAL_INSTANTIATIONS(template, int)
+RATIONAL_INSTANTIATIONS(template, long)
+RATIONAL_INSTANTIATIONS(template, long long)
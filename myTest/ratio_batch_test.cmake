@@ -0,0 +1,11 @@
+# run ratio_batch on INPUT with ARGS and compare its output with EXPECTED
+# cmake -DRATIO_BATCH=<exe> -DARGS=<options> -DINPUT=<file> -DEXPECTED=<file> -P ratio_batch_test.cmake
+separate_arguments(ARGS)
+execute_process(COMMAND ${RATIO_BATCH} ${ARGS} ${INPUT} OUTPUT_VARIABLE output RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "ratio_batch failed : ${result}")
+endif()
+file(READ ${EXPECTED} expected)
+if(NOT output STREQUAL expected)
+	message(FATAL_ERROR "ratio_batch output :\n${output}\nexpected :\n${expected}")
+endif()
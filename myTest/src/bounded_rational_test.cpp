@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "BoundedRational.h"
+#include "ContinuedFraction.h"
+
+using R = Rational<long long>;
+using B = BoundedRational<long long, 1000>;
+
+R exact(const B& value) {
+    return R(value.get_numerator(), value.get_denominator());
+}
+
+// the nearest rounding is as close as the continued fraction best approximation, down <= exact <= up
+void expect_rounding(const R& value, const B& nearest, const B& down, const B& up) {
+    R reference = limit_denominator(value, 1000LL);
+    ASSERT_EQ ((exact(nearest) - value).abs(), (reference - value).abs()) << value;
+    ASSERT_LE (nearest.get_denominator(), 1000);
+    ASSERT_LE (exact(down), value);
+    ASSERT_GE (exact(up), value);
+    ASSERT_TRUE (nearest == down || nearest == up);
+    ASSERT_EQ (down == up, value.get_denominator() <= 1000);
+    // no fraction of denominator <= 1000 between down and up : Farey neighbors
+    if (down != up) {
+        ASSERT_EQ (exact(up).get_numerator() * exact(down).get_denominator() - exact(down).get_numerator() * exact(up).get_denominator(), 1);
+        ASSERT_GT (exact(up).get_denominator() + exact(down).get_denominator(), 1000);
+    }
+}
+
+TEST (BoundedRational, construction) {
+    ASSERT_EQ (B(), B(0));
+    ASSERT_EQ (B(6, 4), B(3, 2));
+    ASSERT_EQ (B(6, -4).get_numerator(), -3);
+    ASSERT_EQ (B(6, 4).error(), 0.0);
+    // 355/113 is exact, pi to 7 digits is rounded to the best fraction of denominator <= 1000
+    ASSERT_EQ (B(355, 113), B(R(355, 113)));
+    ASSERT_EQ (B(3141593, 1000000), B(355, 113));
+    ASSERT_NEAR (B(3141593, 1000000).error(), 3.141593 - 355.0 / 113, 1e-15);
+    ASSERT_EQ (B(3141593, 1000000, RoundingMode::down), B(355, 113));
+    ASSERT_EQ (B(3141593, 1000000, RoundingMode::up), B(2862, 911));
+    // -3.14 is between -22/7 and -25/8
+    ASSERT_EQ ((BoundedRational<int, 10>(-314, 100, RoundingMode::toward_zero)), (BoundedRational<int, 10>(-25, 8)));
+    ASSERT_EQ ((BoundedRational<int, 10>(-314, 100, RoundingMode::down)), (BoundedRational<int, 10>(-22, 7)));
+    ASSERT_THROW (B(1, 0), std::invalid_argument);
+}
+
+TEST (BoundedRational, rounding) {
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<long long> numerator(-5000000, 5000000);
+    std::uniform_int_distribution<long long> denominator(1, 3000000);
+    for (int i = 0; i < 2000; ++i) {
+        R value(numerator(generator), denominator(generator));
+        expect_rounding(value, B(value), B(value, RoundingMode::down), B(value, RoundingMode::up));
+        B toward_zero(value, RoundingMode::toward_zero);
+        ASSERT_LE (exact(toward_zero).abs(), value.abs());
+    }
+    // ties : the smaller denominator, the even integer between 2 integers
+    ASSERT_EQ ((BoundedRational<int, 3>(5, 12)), (BoundedRational<int, 3>(1, 2)));
+    ASSERT_EQ ((BoundedRational<int, 1>(1, 2)), (BoundedRational<int, 1>(0)));
+    ASSERT_EQ ((BoundedRational<int, 1>(3, 2)), (BoundedRational<int, 1>(2)));
+    ASSERT_EQ ((BoundedRational<int, 1>(-3, 2)), (BoundedRational<int, 1>(-2)));
+}
+
+TEST (BoundedRational, operations) {
+    std::mt19937 generator(9);
+    std::uniform_int_distribution<long long> numerator(-3000, 3000);
+    std::uniform_int_distribution<long long> denominator(1, 1000);
+    for (int i = 0; i < 500; ++i) {
+        B a(numerator(generator), denominator(generator));
+        B b(numerator(generator), denominator(generator));
+        R x = exact(a), y = exact(b);
+        expect_rounding(x + y, a + b, a.add(b, RoundingMode::down), a.add(b, RoundingMode::up));
+        expect_rounding(x - y, a - b, a.subtract(b, RoundingMode::down), a.subtract(b, RoundingMode::up));
+        expect_rounding(x * y, a * b, a.multiply(b, RoundingMode::down), a.multiply(b, RoundingMode::up));
+        if (y.get_numerator() != 0) {
+            expect_rounding(x / y, a / b, a.divide(b, RoundingMode::down), a.divide(b, RoundingMode::up));
+        }
+    }
+    B a(7, 3);
+    a += B(1, 3);
+    ASSERT_EQ (a, B(8, 3));
+    a *= B(3, 4);
+    ASSERT_EQ (a, B(2));
+    ASSERT_EQ (-a, B(-2));
+    ASSERT_LT (B(1, 3), B(1, 2));
+    ASSERT_GE (B(1, 2), B(2, 4));
+    ASSERT_THROW (B(1) / B(0), std::invalid_argument);
+    ASSERT_THROW ((BoundedRational<int, 10>(INT_MAX) * BoundedRational<int, 10>(2)), std::overflow_error);
+}
+
+TEST (BoundedRational, pow) {
+    // exact power rounded once
+    expect_rounding(R(32, 243), B(2, 3).pow(5), B(2, 3).pow(5, RoundingMode::down), B(2, 3).pow(5, RoundingMode::up));
+    ASSERT_EQ (B(-2, 3).pow(3), -B(2, 3).pow(3));
+    ASSERT_EQ (B(5, 7).pow(0), B(1));
+    // 7^60 doesn't fit in 128 bits : rounded at every step, still on the requested side
+    long double power = std::pow(1.4L, 60);
+    long double slack = power * 1e-15;
+    ASSERT_LE (power, B(7, 5).pow(60, RoundingMode::up).get_value() + slack);
+    ASSERT_GE (power, B(7, 5).pow(60, RoundingMode::down).get_value() - slack);
+    ASSERT_GE (power, B(7, 5).pow(60, RoundingMode::toward_zero).get_value() - slack);
+    ASSERT_NEAR (B(7, 5).pow(60).get_value(), power, B(7, 5).pow(60).error() + slack);
+    long double negative = -std::pow(1.4L, 61);
+    ASSERT_LE (negative, B(-7, 5).pow(61, RoundingMode::up).get_value() - negative * 1e-15);
+    ASSERT_GE (negative, B(-7, 5).pow(61, RoundingMode::down).get_value() + negative * 1e-15);
+    ASSERT_LE (negative, B(-7, 5).pow(61, RoundingMode::toward_zero).get_value() - negative * 1e-15);
+
+    // huge exponents of 0 and 1 are square and multiply too, not n multiplications
+    using Large = BoundedRational<long long, 1000000>;
+    ASSERT_EQ (Large(1).pow(2000000000), Large(1));
+    ASSERT_EQ (Large(-1).pow(2000000001), Large(-1));
+    ASSERT_EQ (Large(0).pow(4000000000u), Large(0));
+}
+
+TEST (BoundedRational, errorTracking) {
+    // sum of 1/k : the tracked error bounds the distance to the exact harmonic number
+    B sum;
+    R exact_sum(0, 1);
+    for (long long k = 1; k <= 20; ++k) {
+        sum += B(1, k);
+        exact_sum = exact_sum + R(1, k);
+        ASSERT_LE (std::fabs(sum.get_value() - (double)exact_sum.get_numerator() / exact_sum.get_denominator()), sum.error() * (1 + 1e-9) + 1e-15);
+    }
+    ASSERT_GT (sum.error(), 0.0);
+    ASSERT_EQ (sum.exact().error(), 0.0);
+
+    // products and quotients propagate the errors of their operands
+    B third(333, 1000);
+    third = B(1) / B(3) + third - third;
+    B product = third * third * B(9);
+    ASSERT_LE (std::fabs(product.get_value() - 1.0), product.error() + 1e-15);
+    // 1/1500 rounds to 1/1000, 3 of them minus 2/1000 : 1/1000 with an error of 1/1000, the exact divisor may be 0
+    B rounded(1, 1500);
+    B divisor = rounded + rounded + rounded - B(2, 1000);
+    ASSERT_EQ (divisor, B(1, 1000));
+    ASSERT_TRUE (std::isinf((B(1) / divisor).error()));
+}
+
+TEST (BoundedRational, longSimulation) {
+    // Heron's iteration for sqrt(2) : the denominators stay bounded and the value reaches the best approximation
+    BoundedRational<long long, 1000000> x(1);
+    for (int i = 0; i < 1000; ++i) {
+        x = (x + BoundedRational<long long, 1000000>(2) / x) / BoundedRational<long long, 1000000>(2);
+        ASSERT_LE (x.get_denominator(), 1000000);
+    }
+    ASSERT_LT (std::fabs(x.get_value() - std::sqrt(2.0)), 1e-11);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include "ContinuedFraction.h"
+
+using CF = ContinuedFraction<long long>;
+using Ratio = Rational<long long>;
+
+TEST (ContinuedFractionConstructor, rationalConstructor) {
+    CF cf(Ratio(415, 93));
+    ASSERT_EQ (cf.terms(10), (std::vector<long long>{4, 2, 6, 7}));
+    ASSERT_TRUE (cf.is_finite(4));
+
+    CF cf2(Ratio(-7, 3));
+    ASSERT_EQ (cf2.terms(10), (std::vector<long long>{-3, 1, 2}));
+
+    ASSERT_THROW (CF(Ratio(1, 0)), std::invalid_argument);
+}
+
+TEST (ContinuedFractionConstructor, periodic) {
+    CF cf = CF::periodic({1}, {1, 2});
+    ASSERT_EQ (cf.terms(6), (std::vector<long long>{1, 1, 2, 1, 2, 1}));
+    ASSERT_FALSE (cf.is_finite(100));
+}
+
+TEST (ContinuedFractionConstructor, fromReal) {
+    CF cf = CF::from_real(8.4);
+    ASSERT_EQ (cf.to_rational(), Ratio(42, 5));
+}
+
+TEST (ContinuedFractionConstructor, sqrt) {
+    ASSERT_EQ (CF::sqrt(Ratio(2, 1)).terms(5), (std::vector<long long>{1, 2, 2, 2, 2}));
+    ASSERT_EQ (CF::sqrt(Ratio(3, 1)).terms(5), (std::vector<long long>{1, 1, 2, 1, 2}));
+    ASSERT_EQ (CF::sqrt(Ratio(1, 2)).terms(4), (std::vector<long long>{0, 1, 2, 2}));
+    ASSERT_EQ (CF::sqrt(Ratio(4, 9)).to_rational(), Ratio(2, 3));
+    ASSERT_THROW (CF::sqrt(Ratio(-1, 2)), std::invalid_argument);
+
+    // the stream is exact : its convergents stay the best approximations of sqrt(7/5)
+    CF cf = CF::sqrt(Ratio(7, 5));
+    Ratio ratio = cf.convergent(12);
+    ASSERT_NEAR ((long double)ratio.get_numerator() / ratio.get_denominator(), std::sqrt(7.0L / 5), 1e-12);
+}
+
+TEST (ContinuedFractionFunction, lazyTerms) {
+    int calls = 0;
+    CF cf([&calls]() -> std::optional<long long> { ++calls; return 1; });
+    ASSERT_EQ (cf.computed_terms(), 0u);
+    ASSERT_EQ (cf.term(3), 1);
+    ASSERT_EQ (calls, 4);
+    CF copy = cf;
+    copy.term(1);
+    ASSERT_EQ (calls, 4);
+}
+
+TEST (ContinuedFractionFunction, convergent) {
+    CF cf = CF::sqrt(Ratio(2, 1));
+    ASSERT_EQ (cf.convergent(0), Ratio(1, 1));
+    ASSERT_EQ (cf.convergent(1), Ratio(3, 2));
+    ASSERT_EQ (cf.convergent(2), Ratio(7, 5));
+    ASSERT_EQ (cf.convergent(3), Ratio(17, 12));
+}
+
+TEST (ContinuedFractionFunction, approximate) {
+    CF cf = CF::sqrt(Ratio(2, 1));
+    Ratio ratio = cf.approximate(Ratio(1, 1000000));
+    ASSERT_NEAR ((long double)ratio.get_numerator() / ratio.get_denominator(), std::sqrt(2.0L), 1e-6);
+    ASSERT_LT (cf.computed_terms(), 12u);
+
+    ASSERT_EQ (CF(Ratio(3, 7)).approximate(Ratio(1, 1000000)), Ratio(3, 7));
+    ASSERT_THROW (cf.approximate(Ratio(0, 1)), std::invalid_argument);
+}
+
+TEST (ContinuedFractionFunction, bestApproximation) {
+    CF pi = CF::from_terms({3, 7, 15, 1, 292, 1, 1, 1, 2});
+    ASSERT_EQ (pi.best_approximation(1), Ratio(3, 1));
+    ASSERT_EQ (pi.best_approximation(7), Ratio(22, 7));
+    ASSERT_EQ (pi.best_approximation(60), Ratio(179, 57));
+    ASSERT_EQ (pi.best_approximation(100), Ratio(311, 99));
+    ASSERT_EQ (pi.best_approximation(113), Ratio(355, 113));
+
+    ASSERT_EQ (limit_denominator(Ratio(2, 5), 4LL), Ratio(1, 3));
+    ASSERT_EQ (limit_denominator(Ratio(2, 5), 5LL), Ratio(2, 5));
+    ASSERT_EQ (limit_denominator(Ratio(-2, 5), 4LL), Ratio(-1, 3));
+    ASSERT_THROW (limit_denominator(Ratio(2, 5), 0LL), std::invalid_argument);
+}
+
+TEST (ContinuedFractionFunction, compare) {
+    ASSERT_EQ (CF::compare(CF(Ratio(1, 2)), CF(Ratio(1, 3))), 1);
+    ASSERT_EQ (CF::compare(CF(Ratio(-1, 2)), CF(Ratio(1, 3))), -1);
+    ASSERT_EQ (CF::compare(CF(Ratio(5, 7)), CF(Ratio(5, 7))), 0);
+    ASSERT_EQ (CF::compare(CF::sqrt(Ratio(2, 1)), CF(Ratio(7, 5))), 1);
+}
+
+TEST (ContinuedFractionOperator, rationalOperands) {
+    ASSERT_EQ ((CF(Ratio(1, 2)) + CF(Ratio(1, 3))).to_rational(), Ratio(5, 6));
+    ASSERT_EQ ((CF(Ratio(1, 2)) - CF(Ratio(1, 3))).to_rational(), Ratio(1, 6));
+    ASSERT_EQ ((CF(Ratio(415, 93)) * CF(Ratio(93, 415))).to_rational(), Ratio(1, 1));
+    ASSERT_EQ ((CF(Ratio(-3, 4)) / CF(Ratio(5, 2))).to_rational(), Ratio(-3, 10));
+    ASSERT_EQ ((CF(Ratio(1, 3)) + Ratio(-1, 3)).to_rational(), Ratio(0, 1));
+}
+
+TEST (ContinuedFractionOperator, quadraticIrrationals) {
+    CF sqrt2 = CF::sqrt(Ratio(2, 1));
+    CF sqrt3 = CF::sqrt(Ratio(3, 1));
+
+    // sqrt(6) = [2; 2, 4, 2, 4, ...]
+    ASSERT_EQ ((sqrt2 * sqrt3).terms(7), (std::vector<long long>{2, 2, 4, 2, 4, 2, 4}));
+    // sqrt(2) + 1/2
+    Ratio ratio = (sqrt2 + Ratio(1, 2)).approximate(Ratio(1, 1000000000));
+    ASSERT_NEAR ((long double)ratio.get_numerator() / ratio.get_denominator(), std::sqrt(2.0L) + 0.5L, 1e-9);
+    // an exact result of 2 irrational streams is never certain : the stream throws once the precision of T is exhausted
+    ASSERT_THROW ((sqrt2 * sqrt2).to_rational(), std::overflow_error);
+    ASSERT_THROW ((sqrt2 - sqrt2).terms(2), std::overflow_error);
+    // sqrt(2) + sqrt(3) is irrational : its stream goes on until T overflows, it never looks finite
+    ContinuedFraction<int> sum = ContinuedFraction<int>::sqrt(Rational<int>(2, 1)) + ContinuedFraction<int>::sqrt(Rational<int>(3, 1));
+    ASSERT_EQ (sum.terms(4), (std::vector<int>{3, 6, 1, 5}));
+    ASSERT_THROW (sum.is_finite(100), std::overflow_error);
+    ASSERT_THROW (sum.to_rational(), std::overflow_error);
+    ASSERT_THROW (sum.approximate(Rational<int>(1, 2000000000)), std::overflow_error);
+    Rational<int> close = sum.approximate(Rational<int>(1, 1000000));
+    ASSERT_NEAR ((long double)close.get_numerator() / close.get_denominator(), std::sqrt(2.0L) + std::sqrt(3.0L), 1e-6);
+}
+
+TEST (ContinuedFractionOperator, coutOperator) {
+    CF cf(Ratio(415, 93));
+    std::stringstream stream;
+    cf.terms(4);
+    stream << cf;
+    // the end of the expansion is not known until a 5th term is asked for, printing doesn't ask
+    ASSERT_EQ (stream.str(), "[4; 2, 6, 7, ...]");
+    ASSERT_EQ (cf.computed_terms(), 4u);
+    ASSERT_TRUE (cf.is_finite(4));
+    stream.str("");
+    stream << cf;
+    ASSERT_EQ (stream.str(), "[4; 2, 6, 7]");
+
+    std::stringstream stream2;
+    CF sqrt2 = CF::sqrt(Ratio(2, 1));
+    sqrt2.terms(3);
+    stream2 << sqrt2;
+    ASSERT_EQ (stream2.str(), "[1; 2, 2, ...]");
+
+    // sqrt(2) + sqrt(3) on int overflows a few terms later, printing shows the computed ones and doesn't ask for more
+    ContinuedFraction<int> sum = ContinuedFraction<int>::sqrt(Rational<int>(2, 1)) + ContinuedFraction<int>::sqrt(Rational<int>(3, 1));
+    sum.terms(4);
+    std::stringstream stream3;
+    ASSERT_NO_THROW (stream3 << sum);
+    ASSERT_EQ (stream3.str(), "[3; 6, 1, 5, ...]");
+    ASSERT_EQ (sum.computed_terms(), 4u);
+    ASSERT_THROW (sum.is_finite(100), std::overflow_error);
+}
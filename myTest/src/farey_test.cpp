@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+#include "Farey.h"
+
+using R = Rational<long long>;
+
+// reference : every reduced fraction, sorted with Rational comparisons
+std::vector<R> brute_force_farey(long long n) {
+    std::vector<R> terms;
+    for (long long q = 1; q <= n; ++q) {
+        for (long long p = 0; p <= q; ++p) {
+            if (std::gcd(p, q) == 1) {
+                terms.push_back(R(p, q));
+            }
+        }
+    }
+    std::sort(terms.begin(), terms.end(), [](const R& a, const R& b) { return a < b; });
+    return terms;
+}
+
+TEST (Farey, enumeration) {
+    for (long long n = 1; n <= 30; ++n) {
+        FareySequence<long long> farey(n);
+        std::vector<R> expected = brute_force_farey(n);
+        std::vector<R> terms(farey.begin(), farey.end());
+        ASSERT_EQ (terms, expected);
+        ASSERT_EQ (farey.size(), expected.size());
+    }
+    FareySequence<long long> farey5(5);
+    std::vector<R> terms(farey5.begin(), farey5.end());
+    ASSERT_EQ (terms[1], R(1, 5));
+    ASSERT_EQ (terms[4], R(2, 5));
+    ASSERT_THROW (FareySequence<long long>(0), std::invalid_argument);
+}
+
+TEST (Farey, count) {
+    ASSERT_EQ (FareySequence<long long>::count(1), 2u);
+    ASSERT_EQ (FareySequence<long long>::count(8), 23u);
+    ASSERT_EQ (FareySequence<long long>::count(100), 3045u);
+    ASSERT_EQ (FareySequence<long long>::count(1000), 304193u);
+    ASSERT_EQ (FareySequence<long long>::count(1000000), 303963552393u);
+}
+
+TEST (Farey, rankAndAccess) {
+    for (long long n : {1, 2, 7, 23}) {
+        FareySequence<long long> farey(n);
+        std::vector<R> expected = brute_force_farey(n);
+        for (size_t k = 0; k < expected.size(); ++k) {
+            ASSERT_EQ (farey[k], expected[k]);
+            ASSERT_EQ (farey.rank(expected[k]), k + 1);
+        }
+        ASSERT_THROW (farey[expected.size()], std::invalid_argument);
+    }
+    FareySequence<long long> farey(7);
+    ASSERT_EQ (farey.rank(R(-1, 2)), 0u);
+    ASSERT_EQ (farey.rank(R(3, 2)), farey.size());
+    ASSERT_EQ (farey.rank(R(1, 8)), 1u);
+
+    FareySequence<long long> large(2000);
+    R term = large[large.size() / 3];
+    ASSERT_EQ (large.rank(term), large.size() / 3 + 1);
+}
+
+TEST (Farey, neighbors) {
+    FareySequence<long long> farey(8);
+    std::vector<R> expected = brute_force_farey(8);
+    for (size_t k = 1; k + 1 < expected.size(); ++k) {
+        ASSERT_EQ (farey.neighbors(expected[k]), std::make_pair(expected[k - 1], expected[k + 1]));
+    }
+    // values that are not terms, outside of [0, 1] too
+    ASSERT_EQ (farey.neighbors(R(1, 9)), std::make_pair(R(0), R(1, 8)));
+    ASSERT_EQ (farey.neighbors(R(31, 100)), std::make_pair(R(2, 7), R(1, 3)));
+    ASSERT_EQ (farey.neighbors(R(231, 100)), std::make_pair(R(16, 7), R(7, 3)));
+    ASSERT_EQ (farey.neighbors(R(-69, 100)), std::make_pair(R(-5, 7), R(-2, 3)));
+    ASSERT_EQ (farey.neighbors(R(2)), std::make_pair(R(15, 8), R(17, 8)));
+
+    // best rational approximations of pi bracket it
+    FareySequence<long long> large(1000);
+    std::pair<R, R> pi = large.neighbors(R().convert_real_to_ratio(3.14159265358979, 20));
+    ASSERT_EQ (pi, std::make_pair(R(2818, 897), R(355, 113)));
+}
+
+TEST (Farey, chunks) {
+    FareySequence<long long> farey(50);
+    std::vector<R> expected(farey.begin(), farey.end());
+    std::vector<R> chained;
+    size_t position = 0;
+    for (const auto& range : farey.chunks(7)) {
+        ASSERT_EQ (range.position(), position);
+        position += range.size();
+        chained.insert(chained.end(), range.begin(), range.end());
+    }
+    ASSERT_EQ (chained, expected);
+
+    std::atomic<long long> denominators(0);
+    std::atomic<size_t> nb_terms(0);
+    farey.parallel_for_each([&](const R& term) {
+        denominators += term.get_denominator();
+        ++nb_terms;
+    }, 4);
+    long long expected_denominators = 0;
+    for (const R& term : expected) {
+        expected_denominators += term.get_denominator();
+    }
+    ASSERT_EQ (denominators.load(), expected_denominators);
+    ASSERT_EQ (nb_terms.load(), expected.size());
+}
+
+TEST (SternBrocot, path) {
+    SternBrocotPath<long long> path(R(7, 3));
+    ASSERT_EQ (path.to_string(), "RRLL");
+    ASSERT_EQ (path.depth(), 4u);
+    std::vector<R> nodes(path.begin(), path.end());
+    ASSERT_EQ (nodes, std::vector<R>({R(1), R(2), R(3), R(5, 2), R(7, 3)}));
+    ASSERT_EQ (SternBrocotPath<long long>::node("RRLL"), R(7, 3));
+
+    SternBrocotPath<long long> root(R(1));
+    ASSERT_EQ (root.to_string(), "");
+    ASSERT_EQ (root.size(), 1u);
+
+    SternBrocotPath<long long> small(R(3, 11));
+    ASSERT_EQ (small.run_lengths(), (std::vector<std::pair<char, long long>>{{'L', 3}, {'R', 1}, {'L', 1}}));
+    ASSERT_EQ (SternBrocotPath<long long>::node(small.to_string()), R(3, 11));
+    std::vector<R> small_nodes(small.begin(), small.end());
+    ASSERT_EQ (small_nodes.back(), R(3, 11));
+    ASSERT_EQ (small_nodes.size(), 6u);
+
+    ASSERT_THROW (SternBrocotPath<long long>(R(-1, 2)), std::invalid_argument);
+    ASSERT_THROW (SternBrocotPath<long long>::node("LX"), std::invalid_argument);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "Geometry.h"
+
+using P2 = Point2<int>;
+using P3 = Point3<int>;
+
+TEST (WideInt, arithmetic) {
+    WideInt<3> a(std::numeric_limits<long long>::max());
+    WideInt<3> b(-3);
+    ASSERT_EQ ((a * a * b).sign(), -1);
+    ASSERT_EQ ((a * a - a * a).sign(), 0);
+    ASSERT_EQ ((b * b - WideInt<3>(9)).sign(), 0);
+    ASSERT_EQ ((a * a + WideInt<3>(1) - a * a).sign(), 1);
+}
+
+TEST (Geometry, pointOperators) {
+    P2 a(Rational<int>(1, 2), 3);
+    P2 b(0.25, -1);
+    ASSERT_EQ (a + b, P2(Rational<int>(3, 4), 2));
+    ASSERT_EQ (a - b, P2(Rational<int>(1, 4), 4));
+    ASSERT_EQ (a * Rational<int>(2, 1), P2(1, 6));
+    ASSERT_EQ (dot(a, b), Rational<int>(-23, 8));
+    ASSERT_EQ (cross(a, b), Rational<int>(-5, 4));
+    ASSERT_EQ (cross(P3(1, 0, 0), P3(0, 1, 0)), P3(0, 0, 1));
+    ASSERT_EQ (dot(P3(1, 2, 3), P3(4, 5, 6)), Rational<int>(32, 1));
+
+    // intermediate cross products over 2^31, exact results that fit in int
+    P2 u(Rational<int>(46337, 46349), Rational<int>(1, 46351)), v(Rational<int>(46349, 46337), Rational<int>(46351, 1));
+    ASSERT_EQ (dot(u, v), Rational<int>(2, 1));
+    ASSERT_EQ (cross(P3(u.x, 0, 0), P3(v.x, 0, 1)), P3(0, Rational<int>(-46337, 46349), 0));
+    // results that don't fit throw instead of wrapping
+    ASSERT_THROW (u + v, std::overflow_error);
+    ASSERT_THROW (dot(u, P2(Rational<int>(1, 46337), 1)), std::overflow_error);
+    ASSERT_THROW (P3(0, 0, Rational<int>(1, 46337)) * Rational<int>(1, 46349), std::overflow_error);
+}
+
+TEST (Geometry, orient2d) {
+    ASSERT_EQ (orient2d(P2(0, 0), P2(1, 0), P2(0, 1)), 1);
+    ASSERT_EQ (orient2d(P2(0, 0), P2(0, 1), P2(1, 0)), -1);
+    ASSERT_EQ (orient2d(P2(0, 0), P2(1, 1), P2(3, 3)), 0);
+    ASSERT_EQ (orient2d_exact(P2(0, 0), P2(1, 0), P2(0, 1)), 1);
+    ASSERT_EQ (orient2d_exact(P2(0, 0), P2(0, 1), P2(1, 0)), -1);
+
+    // doubles that are not exact in binary, collinear once converted
+    ASSERT_EQ (orient2d(P2(0.1, 0.1), P2(0.2, 0.2), P2(0.3, 0.3)), 0);
+    ASSERT_EQ (orient2d(P2(0.1, 0.2), P2(0.3, 0.4), P2(0.7, 0.8)), 0);
+
+    // the products overflow an int
+    P2 b(Rational<int>(1, 46341), Rational<int>(1, 46340));
+    P2 c(Rational<int>(2, 46341), Rational<int>(1, 23170));
+    ASSERT_EQ (orient2d(P2(0, 0), b, c), 0);
+    ASSERT_EQ (orient2d(P2(0, 0), b, P2(Rational<int>(2, 46341), Rational<int>(1, 23169))), 1);
+    P2 big(Rational<int>(2147483646, 2147483647), Rational<int>(-2147483646, 3));
+    P2 half(Rational<int>(1073741823, 2147483647), Rational<int>(-1073741823, 3));
+    ASSERT_EQ (orient2d(big, half, P2(0, 0)), 0);
+    ASSERT_EQ (orient2d(big, half, P2(0, Rational<int>(1, 2147483647))), -1);
+}
+
+TEST (Geometry, orient2dFilterAgreesWithExact) {
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<long long> numerator(-1000, 1000);
+    std::uniform_int_distribution<long long> denominator(1, 1000);
+    // long long : the denominators of d reach 10^18, the Point operations throw rather than wrap in int
+    using L2 = Point2<long long>;
+    using LR = Rational<long long>;
+    auto random_point = [&]() { return L2(LR(numerator(generator), denominator(generator)), LR(numerator(generator), denominator(generator))); };
+    for (int i = 0; i < 1000; ++i)
+    {
+        L2 a = random_point(), b = random_point(), c = random_point();
+        ASSERT_EQ (orient2d(a, b, c), orient2d_exact(a, b, c));
+        // near degenerate : c on the line ab, moved by a tiny amount
+        L2 d = a + (b - a) * LR(numerator(generator), 1000) + L2(LR(i % 3 - 1, 1000000), 0);
+        ASSERT_EQ (orient2d(a, b, d), orient2d_exact(a, b, d));
+    }
+}
+
+TEST (Geometry, orient3d) {
+    P3 a(0, 0, 0), b(1, 0, 0), c(0, 1, 0);
+    ASSERT_EQ (orient3d(a, b, c, P3(0, 0, -1)), 1);
+    ASSERT_EQ (orient3d(a, b, c, P3(0, 0, 1)), -1);
+    ASSERT_EQ (orient3d(a, b, c, P3(5, 7, 0)), 0);
+    ASSERT_EQ (orient3d_exact(a, b, c, P3(0, 0, -1)), 1);
+    ASSERT_EQ (orient3d_exact(a, b, c, P3(0, 0, 1)), -1);
+    ASSERT_EQ (orient3d_exact(a, b, c, P3(5, 7, 0)), 0);
+
+    // coplanar with large denominators
+    P3 u(Rational<int>(1, 46337), Rational<int>(2, 46349), Rational<int>(3, 46351));
+    P3 v(Rational<int>(5, 46327), Rational<int>(-7, 46309), Rational<int>(1, 46307));
+    ASSERT_EQ (orient3d(a, u, v, u + v), 0);
+    ASSERT_EQ (orient3d(a, u, v, u - v), 0);
+    P3 near = u + v + P3(0, 0, Rational<int>(1, 46351));
+    ASSERT_EQ (orient3d(a, u, v, near), orient3d_exact(a, u, v, near));
+    // the exact sum doesn't fit in int, it throws instead of wrapping
+    ASSERT_THROW (u + v + P3(0, 0, Rational<int>(1, 2147483647)), std::overflow_error);
+}
+
+TEST (Geometry, incircle) {
+    P2 a(0, 0), b(1, 0), c(0, 1);
+    ASSERT_EQ (incircle(a, b, c, P2(Rational<int>(1, 2), Rational<int>(1, 2))), 1);
+    ASSERT_EQ (incircle(a, b, c, P2(1, 1)), 0);
+    ASSERT_EQ (incircle(a, b, c, P2(2, 2)), -1);
+    ASSERT_EQ (incircle_exact(a, b, c, P2(Rational<int>(1, 2), Rational<int>(1, 2))), 1);
+    ASSERT_EQ (incircle_exact(a, b, c, P2(1, 1)), 0);
+    ASSERT_EQ (incircle_exact(a, b, c, P2(2, 2)), -1);
+
+    // rational points of the unit circle ((1 - t^2) / (1 + t^2), 2t / (1 + t^2))
+    auto on_circle = [](int p, int q) { return P2(Rational<int>(q * q - p * p, q * q + p * p), Rational<int>(2 * p * q, q * q + p * p)); };
+    P2 e = on_circle(1, 7), f = on_circle(3, 11), g = on_circle(13, 17), h = on_circle(-5, 101);
+    ASSERT_EQ (incircle(e, f, g, h), 0);
+    ASSERT_EQ (incircle(e, f, g, h * Rational<int>(99, 100)), 1);
+    ASSERT_EQ (incircle(e, f, g, h * Rational<int>(101, 100)), -1);
+}
+
+TEST (Geometry, segmentsIntersect) {
+    ASSERT_TRUE (segments_intersect(P2(0, 0), P2(1, 1), P2(0, 1), P2(1, 0)));
+    ASSERT_FALSE (segments_intersect(P2(0, 0), P2(1, 1), P2(2, 0), P2(3, -1)));
+    ASSERT_TRUE (segments_intersect(P2(0, 0), P2(2, 0), P2(1, 0), P2(1, 5)));     // T junction
+    ASSERT_TRUE (segments_intersect(P2(0, 0), P2(2, 0), P2(1, 0), P2(3, 0)));     // collinear overlap
+    ASSERT_FALSE (segments_intersect(P2(0, 0), P2(1, 0), P2(2, 0), P2(3, 0)));    // collinear disjoint
+    ASSERT_TRUE (segments_intersect(P2(0.1, 0.1), P2(0.3, 0.3), P2(0.2, 0.2), P2(0.2, 0.5)));
+
+    // collinear on y = x, the coordinate comparisons have cross products over 2^31
+    Rational<int> ax(64967, 40581), bx(38263, 35136), mx(43880, 33231);
+    ASSERT_TRUE (on_segment(P2(mx, mx), P2(ax, ax), P2(bx, bx)));
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> large(30000, 65000);
+    for (int i = 0; i < 10000; ++i)
+    {
+        Rational<int> a(large(generator), large(generator)), b(large(generator), large(generator)), m(large(generator), large(generator));
+        auto less_equal = [](const Rational<int>& x, const Rational<int>& y)
+        {
+            return (long long)(x.get_numerator()) * y.get_denominator() <= (long long)(y.get_numerator()) * x.get_denominator();
+        };
+        bool expected = (less_equal(a, m) && less_equal(m, b)) || (less_equal(b, m) && less_equal(m, a));
+        ASSERT_EQ (on_segment(P2(m, m), P2(a, a), P2(b, b)), expected) << a << " " << b << " " << m;
+        ASSERT_EQ (segments_intersect(P2(m, m), P2(m, m), P2(a, a), P2(b, b)), expected);
+    }
+}
+
+TEST (Geometry, intersectionPoint) {
+    std::optional<Point2<long long>> p = intersection_point(P2(0, 0), P2(1, 1), P2(0, 1), P2(1, 0));
+    ASSERT_TRUE (p.has_value());
+    ASSERT_EQ (p->x, Rational<long long>(1, 2));
+    ASSERT_EQ (p->y, Rational<long long>(1, 2));
+
+    ASSERT_FALSE (intersection_point(P2(0, 0), P2(1, 1), P2(2, 0), P2(3, -1)).has_value());
+    ASSERT_FALSE (intersection_point(P2(0, 0), P2(2, 0), P2(1, 0), P2(3, 0)).has_value());  // overlap
+    p = intersection_point(P2(0, 0), P2(1, 0), P2(1, 0), P2(3, 0));                         // collinear, one common end
+    ASSERT_TRUE (p.has_value());
+    ASSERT_EQ (p->x, Rational<long long>(1, 1));
+
+    // the result needs more than an int
+    P2 a(Rational<int>(1, 46341), 0), b(Rational<int>(1, 46337), 1);
+    P2 c(0, Rational<int>(1, 46349)), d(1, Rational<int>(1, 46351));
+    p = intersection_point(a, b, c, d);
+    ASSERT_TRUE (p.has_value());
+    ASSERT_EQ (p->x, Rational<long long>(99546819821567LL, 4613099168759429591LL));
+    ASSERT_EQ (p->y, Rational<long long>(99529637413193LL, 4613099168759429591LL));
+    Point2<long long> a2(Rational<long long>(1, 46341), 0), b2(Rational<long long>(1, 46337), 1);
+    Point2<long long> c2(0, Rational<long long>(1, 46349)), d2(1, Rational<long long>(1, 46351));
+    ASSERT_EQ (orient2d_exact(a2, b2, *p), 0);
+    ASSERT_EQ (orient2d_exact(c2, d2, *p), 0);
+    p = intersection_point(P2(Rational<int>(1, 3), 0), P2(Rational<int>(2, 3), 1), P2(0, Rational<int>(1, 7)), P2(1, Rational<int>(5, 7)));
+    ASSERT_EQ (*p, Point2<long long>(Rational<long long>(8, 17), Rational<long long>(7, 17)));
+    // the reduced point doesn't fit in a long long
+    P2 e(Rational<int>(1, 46341), Rational<int>(1, 46343)), f(Rational<int>(46340, 46337), Rational<int>(46338, 46339));
+    P2 g(Rational<int>(1, 46349), Rational<int>(46350, 46351)), h(Rational<int>(46344, 46347), Rational<int>(2, 46353));
+    ASSERT_THROW (intersection_point(e, f, g, h), std::overflow_error);
+}
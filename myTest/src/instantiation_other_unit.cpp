@@ -0,0 +1,32 @@
+// second translation unit of myInstantiationTests : every header is included again to check they link from several units
+#include "Rational.h"
+#include "RationalStats.h"
+#include "ContinuedFraction.h"
+#include "MultiModular.h"
+#include "Geometry.h"
+#include "LinearProgram.h"
+#include "Farey.h"
+
+int other_unit_nb_iter() {
+    return default_nb_iter;
+}
+
+void other_unit_set_nb_iter(int nb_iter) {
+    default_nb_iter = nb_iter;
+}
+
+Rational<int> other_unit_int(const Rational<int>& a) {
+    return (a + 1) * 2.5 - a / 3L;
+}
+
+Rational<long> other_unit_long(const Rational<long>& a) {
+    return (a + 1) * 2.5 - a / 3L;
+}
+
+Rational<long long> other_unit_long_long(const Rational<long long>& a) {
+    return (a + 1) * 2.5 - a / 3L;
+}
+
+Rational<long long> other_unit_limit(const Rational<long long>& a) {
+    return limit_denominator(a, 100LL);
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include "Rational.h"
+#include "ContinuedFraction.h"
+#include "MultiModular.h"
+#include "Geometry.h"
+#include "LinearProgram.h"
+#include "Farey.h"
+
+// defined in instantiation_other_unit.cpp
+int other_unit_nb_iter();
+void other_unit_set_nb_iter(int nb_iter);
+Rational<int> other_unit_int(const Rational<int>& a);
+Rational<long> other_unit_long(const Rational<long>& a);
+Rational<long long> other_unit_long_long(const Rational<long long>& a);
+Rational<long long> other_unit_limit(const Rational<long long>& a);
+
+TEST (Instantiation, sharedGlobals) {
+    ASSERT_EQ (other_unit_nb_iter(), default_nb_iter);
+    int saved = default_nb_iter;
+    other_unit_set_nb_iter(3);
+    ASSERT_EQ (default_nb_iter, 3);
+    default_nb_iter = saved;
+    ASSERT_EQ (other_unit_nb_iter(), saved);
+}
+
+TEST (Instantiation, operandTypes) {
+    ASSERT_EQ (other_unit_int(Rational<int>(3, 4)), Rational<int>(33, 8));
+    ASSERT_EQ (other_unit_long(Rational<long>(3, 4)), Rational<long>(33, 8));
+    ASSERT_EQ (other_unit_long_long(Rational<long long>(3, 4)), Rational<long long>(33, 8));
+    ASSERT_EQ (other_unit_int(Rational<int>(3, 4)), (Rational<int>(3, 4) + 1) * 2.5 - Rational<int>(3, 4) / 3L);
+    ASSERT_EQ (other_unit_limit(Rational<long long>(314159, 100000)), Rational<long long>(311, 99));
+
+    std::ostringstream stream;
+    stream << Rational<long>(-2, 6);
+    ASSERT_EQ (stream.str(), "-1/3");
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "LinearProgram.h"
+
+using R = Rational<long long>;
+using LP = LinearProgram<long long>;
+using Solution = LinearProgramSolution<long long>;
+
+// strong duality and feasibility, exactly
+void check_certificate(const LP& program, const std::vector<std::vector<R>>& rows, const std::vector<R>& rhs, const Solution& solution) {
+    R dual_objective;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        dual_objective += rhs[i] * solution.duals[i];
+    }
+    ASSERT_EQ (dual_objective, solution.objective);
+    for (const R& value : solution.x) {
+        ASSERT_TRUE (value >= 0);
+    }
+    ASSERT_EQ (solution.x.size(), program.nb_variables());
+}
+
+TEST (LinearProgram, textbook) {
+    // max 3x + 5y, x <= 4, 2y <= 12, 3x + 2y <= 18
+    LP program(2);
+    program.set_objective({R(3), R(5)});
+    std::vector<std::vector<R>> rows = {{R(1), R(0)}, {R(0), R(2)}, {R(3), R(2)}};
+    std::vector<R> rhs = {R(4), R(12), R(18)};
+    for (size_t i = 0; i < rows.size(); ++i) {
+        program.add_constraint(rows[i], LP::less_equal, rhs[i]);
+    }
+    for (bool float_guided : {true, false}) {
+        Solution solution = program.solve(float_guided);
+        ASSERT_EQ (solution.status, Solution::optimal);
+        ASSERT_EQ (solution.objective, R(36));
+        ASSERT_EQ (solution.x, std::vector<R>({R(2), R(6)}));
+        ASSERT_EQ (solution.duals, std::vector<R>({R(0), R(3, 2), R(1)}));
+        check_certificate(program, rows, rhs, solution);
+    }
+}
+
+TEST (LinearProgram, nonDyadicOptimum) {
+    // max x + y, 3x + y <= 1, x + 3y <= 1 : x = y = 1/4, not representable after a few float pivots
+    LP program(2);
+    program.set_objective({R(1), R(1)});
+    program.add_constraint({R(3), R(1)}, LP::less_equal, R(1));
+    program.add_constraint({R(1), R(3)}, LP::less_equal, R(1));
+    Solution solution = program.solve();
+    ASSERT_EQ (solution.status, Solution::optimal);
+    ASSERT_EQ (solution.x, std::vector<R>({R(1, 4), R(1, 4)}));
+    ASSERT_EQ (solution.duals, std::vector<R>({R(1, 4), R(1, 4)}));
+    ASSERT_EQ (solution.objective, R(1, 2));
+    ASSERT_EQ (solution.exact_pivots, 0u);
+}
+
+TEST (LinearProgram, bealeCycling) {
+    // Beale's example cycles with Dantzig's rule and naive tie breaking
+    LP program(4);
+    program.set_objective({R(3, 4), R(-150), R(1, 50), R(-6)});
+    std::vector<std::vector<R>> rows = {{R(1, 4), R(-60), R(-1, 25), R(9)}, {R(1, 2), R(-90), R(-1, 50), R(3)}, {R(0), R(0), R(1), R(0)}};
+    std::vector<R> rhs = {R(0), R(0), R(1)};
+    for (size_t i = 0; i < rows.size(); ++i) {
+        program.add_constraint(rows[i], LP::less_equal, rhs[i]);
+    }
+    for (bool float_guided : {true, false}) {
+        Solution solution = program.solve(float_guided);
+        ASSERT_EQ (solution.status, Solution::optimal);
+        ASSERT_EQ (solution.objective, R(1, 20));
+        ASSERT_EQ (solution.x, std::vector<R>({R(1, 25), R(0), R(1), R(0)}));
+        check_certificate(program, rows, rhs, solution);
+    }
+}
+
+TEST (LinearProgram, greaterEqualAndEqual) {
+    // min x + y, x + 2y >= 4, 3x + y >= 6
+    LP program(2);
+    program.set_objective({R(-1), R(-1)});
+    std::vector<std::vector<R>> rows = {{R(1), R(2)}, {R(3), R(1)}};
+    std::vector<R> rhs = {R(4), R(6)};
+    program.add_constraint(rows[0], LP::greater_equal, rhs[0]);
+    program.add_constraint(rows[1], LP::greater_equal, rhs[1]);
+    Solution solution = program.solve();
+    ASSERT_EQ (solution.status, Solution::optimal);
+    ASSERT_EQ (solution.objective, R(-14, 5));
+    ASSERT_EQ (solution.x, std::vector<R>({R(8, 5), R(6, 5)}));
+    check_certificate(program, rows, rhs, solution);
+
+    // -x - y = -2 is x + y = 2, sparse form
+    LP equality(2);
+    equality.set_objective({R(1), R(0)});
+    equality.add_constraint(LP::SparseRow{{0, R(-1)}, {1, R(-1)}}, LP::equal, R(-2));
+    Solution eq = equality.solve();
+    ASSERT_EQ (eq.status, Solution::optimal);
+    ASSERT_EQ (eq.objective, R(2));
+    ASSERT_EQ (eq.duals, std::vector<R>({R(-1)}));
+}
+
+TEST (LinearProgram, infeasibleAndUnbounded) {
+    LP infeasible(1);
+    infeasible.set_objective({R(1)});
+    infeasible.add_constraint({R(1)}, LP::less_equal, R(1));
+    infeasible.add_constraint({R(1)}, LP::greater_equal, R(2));
+    ASSERT_EQ (infeasible.solve().status, Solution::infeasible);
+    ASSERT_EQ (infeasible.solve(false).status, Solution::infeasible);
+
+    // infeasible by 1e-12 : the floating point phase 1 takes it for feasible, the exact certificate must not
+    LP nearly(1);
+    nearly.set_objective({R(1)});
+    nearly.add_constraint({R(1)}, LP::less_equal, R(1));
+    nearly.add_constraint({R(1)}, LP::greater_equal, R(1000000000001LL, 1000000000000LL));
+    ASSERT_EQ (nearly.solve().status, Solution::infeasible);
+    ASSERT_EQ (nearly.solve(false).status, Solution::infeasible);
+    // feasible by 1e-12 : x = 1 is found exactly
+    LP tight(1);
+    tight.set_objective({R(-1)});
+    tight.add_constraint({R(1)}, LP::less_equal, R(1000000000001LL, 1000000000000LL));
+    tight.add_constraint({R(1)}, LP::greater_equal, R(1));
+    Solution solution = tight.solve();
+    ASSERT_EQ (solution.status, Solution::optimal);
+    ASSERT_EQ (solution.x[0], R(1));
+
+    LP unbounded(2);
+    unbounded.set_objective({R(1), R(0)});
+    unbounded.add_constraint({R(1), R(-1)}, LP::less_equal, R(1));
+    ASSERT_EQ (unbounded.solve().status, Solution::unbounded);
+    ASSERT_EQ (unbounded.solve(false).status, Solution::unbounded);
+}
+
+TEST (LinearProgram, kleeMinty) {
+    // max sum 2^(n-i) x_i, 2 sum_{j<i} 2^(i-j) x_j + x_i <= 5^i : optimum 5^n at x_n = 5^n
+    const size_t n = 6;
+    LP program(n);
+    std::vector<R> objective;
+    long long power_of_5 = 1;
+    for (size_t i = 0; i < n; ++i) {
+        objective.push_back(R(1ll << (n - 1 - i)));
+        std::vector<R> row(n);
+        for (size_t j = 0; j < i; ++j) {
+            row[j] = R(1ll << (i - j + 1));
+        }
+        row[i] = R(1);
+        power_of_5 *= 5;
+        program.add_constraint(row, LP::less_equal, R(power_of_5));
+    }
+    program.set_objective(objective);
+    Solution solution = program.solve();
+    ASSERT_EQ (solution.status, Solution::optimal);
+    ASSERT_EQ (solution.objective, R(power_of_5));
+    ASSERT_EQ (solution.x.back(), R(power_of_5));
+}
+
+// maximize sum x_j / (j + 1) under H x = H 1 (Hilbert rows) and x >= 0 : the optimum is x = 1, the objective the harmonic number
+template<typename T>
+LinearProgram<T> hilbert_program(const int n) {
+    LinearProgram<T> program(n);
+    std::vector<Rational<T>> objective;
+    for (int j = 0; j < n; ++j) {
+        objective.push_back(Rational<T>(1, j + 1));
+    }
+    program.set_objective(objective);
+    for (int i = 0; i < n; ++i) {
+        std::vector<Rational<T>> row;
+        Rational<T> rhs;
+        for (int j = 0; j < n; ++j) {
+            row.push_back(Rational<T>(1, i + j + 1));
+            rhs += row.back();
+        }
+        program.add_constraint(row, LinearProgram<T>::equal, rhs);
+    }
+    return program;
+}
+
+TEST (LinearProgram, illConditioned) {
+    // the certificate and the exact pivots are checked : the right optimum, or an overflow, never a wrapped status
+    for (int n : {6, 7}) {
+        LinearProgramSolution<int> solution = hilbert_program<int>(n).solve();
+        ASSERT_EQ (solution.status, LinearProgramSolution<int>::optimal) << n;
+        ASSERT_EQ (solution.x, std::vector<Rational<int>>(n, Rational<int>(1, 1))) << n;
+    }
+    ASSERT_THROW (hilbert_program<int>(8).solve(), std::overflow_error);
+    ASSERT_THROW (hilbert_program<int>(8).solve(false), std::overflow_error);
+
+    for (int n : {10, 11, 12}) {
+        for (bool float_guided : {true, false}) {
+            Solution solution = hilbert_program<long long>(n).solve(float_guided);
+            ASSERT_EQ (solution.status, Solution::optimal) << n;
+            ASSERT_EQ (solution.x, std::vector<R>(n, R(1))) << n;
+            R harmonic;
+            for (int j = 1; j <= n; ++j) {
+                harmonic += R(1, j);
+            }
+            ASSERT_EQ (solution.objective, harmonic) << n;
+        }
+    }
+}
+
+TEST (LinearProgram, invalidArguments) {
+    LP program(2);
+    ASSERT_THROW (program.set_objective({R(1)}), std::invalid_argument);
+    ASSERT_THROW (program.add_constraint({R(1)}, LP::less_equal, R(1)), std::invalid_argument);
+    ASSERT_THROW (program.add_constraint(LP::SparseRow{{2, R(1)}}, LP::less_equal, R(1)), std::invalid_argument);
+}
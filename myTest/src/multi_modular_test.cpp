@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+#include "MultiModular.h"
+
+using Ratio = Rational<long long>;
+
+TEST (MontgomeryField, isPrime) {
+    ASSERT_TRUE (MontgomeryField::is_prime(2));
+    ASSERT_TRUE (MontgomeryField::is_prime(1000000007));
+    ASSERT_FALSE (MontgomeryField::is_prime(1));
+    ASSERT_FALSE (MontgomeryField::is_prime(561));          // Carmichael number
+    ASSERT_FALSE (MontgomeryField::is_prime(3215031751ULL)); // strong pseudoprime to bases 2, 3, 5, 7
+    ASSERT_TRUE (MontgomeryField::is_prime(9223372036854775783ULL)); // largest prime under 2^63
+}
+
+TEST (MontgomeryField, largestPrimes) {
+    std::vector<uint64_t> primes = MontgomeryField::largest_primes(3);
+    ASSERT_EQ (primes.size(), 3u);
+    ASSERT_EQ (primes[0], 9223372036854775783ULL);
+    ASSERT_GT (primes[0], primes[1]);
+    ASSERT_GT (primes[1], primes[2]);
+}
+
+TEST (MontgomeryField, arithmetic) {
+    MontgomeryField field(1000000007);
+    uint64_t a = field.from_integer(123456789);
+    uint64_t b = field.from_integer(-987654321);
+    ASSERT_EQ (field.from_montgomery(field.mul(a, b)), uint64_t((123456789LL * (1000000007LL - 987654321LL)) % 1000000007LL));
+    ASSERT_EQ (field.from_montgomery(field.add(a, b)), uint64_t(123456789LL - 987654321LL + 1000000007LL));
+    ASSERT_EQ (field.from_montgomery(field.mul(a, field.inverse(a))), 1u);
+    ASSERT_THROW (field.inverse(0), std::invalid_argument);
+    ASSERT_THROW (MontgomeryField(10), std::invalid_argument);
+
+    // 1/2 * 2 = 1
+    uint64_t half = *field.from_rational(Ratio(1, 2));
+    ASSERT_EQ (field.from_montgomery(field.mul(half, field.from_integer(2))), 1u);
+    ASSERT_FALSE (field.from_rational(Ratio(1, 1000000007)).has_value());
+}
+
+TEST (MultiModular, crtAndReconstruction) {
+    std::vector<uint64_t> primes = MontgomeryField::largest_primes(2);
+    unsigned __int128 x = crt_combine(5, primes[0], 5, primes[1]);
+    ASSERT_TRUE (x == 5);
+
+    // -22/7 modulo p
+    MontgomeryField field(primes[0]);
+    uint64_t residue = field.from_montgomery(*field.from_rational(Ratio(-22, 7)));
+    std::optional<Ratio> ratio = rational_reconstruction<long long>(residue, primes[0]);
+    ASSERT_TRUE (ratio.has_value());
+    ASSERT_EQ (*ratio, Ratio(-22, 7));
+    ASSERT_TRUE (rational_matches(*ratio, residue, primes[0]));
+}
+
+TEST (MultiModular, modularNumber) {
+    std::vector<uint64_t> primes = MontgomeryField::largest_primes(3);
+    ModularNumber a(primes, Ratio(1, 3));
+    ModularNumber b(primes, Ratio(-5, 7));
+    ASSERT_EQ ((a + b).to_rational<long long>(), Ratio(-8, 21));
+    ASSERT_EQ ((a - b).to_rational<long long>(), Ratio(22, 21));
+    ASSERT_EQ ((a * b).to_rational<long long>(), Ratio(-5, 21));
+    ASSERT_EQ ((a / b).to_rational<long long>(), Ratio(-7, 15));
+
+    // needs the 2 first primes : numerator and denominator are over 2^31
+    ModularNumber c(primes, Ratio(3000000019LL, 1));
+    ModularNumber d(primes, Ratio(1, 4000000007LL));
+    ASSERT_EQ ((c * d).to_rational<long long>(), Ratio(3000000019LL, 4000000007LL));
+}
+
+TEST (MultiModular, tooLarge) {
+    std::vector<uint64_t> primes = MontgomeryField::largest_primes(3);
+    ModularNumber a(primes, Ratio(3000000019LL, 4000000007LL));
+    ASSERT_THROW (a.to_rational<int>(), std::overflow_error);
+    ModularNumber big(primes, Ratio(std::numeric_limits<long long>::max(), 1));
+    ASSERT_THROW ((big * big).to_rational<long long>(), std::overflow_error);
+}
+
+TEST (MultiModular, modularSolve) {
+    // Hilbert matrix, the classic ill conditioned system
+    const size_t n = 6;
+    std::vector<std::vector<Ratio>> A(n, std::vector<Ratio>(n));
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            A[i][j] = Ratio(1, (long long)(i + j + 1));
+        }
+    }
+    std::vector<Ratio> x = {Ratio(1, 2), Ratio(-3, 1), Ratio(7, 5), Ratio(0, 1), Ratio(-1, 9), Ratio(11, 4)};
+    std::vector<Ratio> b(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            b[i] += A[i][j] * x[j];
+        }
+    }
+
+    std::vector<Ratio> solution = modular_solve(A, b);
+    ASSERT_EQ (solution.size(), n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ASSERT_EQ (solution[i], x[i]);
+    }
+}
+
+TEST (MultiModular, singularMatrix) {
+    std::vector<std::vector<Ratio>> A = {{Ratio(1, 1), Ratio(2, 1)}, {Ratio(2, 1), Ratio(4, 1)}};
+    std::vector<Ratio> b = {Ratio(1, 1), Ratio(2, 1)};
+    ASSERT_THROW (modular_solve(A, b, 4), std::invalid_argument);
+    ASSERT_THROW (modular_solve(A, {Ratio(1, 1)}), std::invalid_argument);
+}
+
+TEST (MultiModular, earlyTermination) {
+    // a small result is confirmed by the first batch of 2 primes, the 6 others never run
+    std::atomic<int> calls{0};
+    std::vector<Ratio> result = multi_modular<long long>([&calls](const MontgomeryField& field) {
+        ++calls;
+        return std::optional<std::vector<uint64_t>>(std::vector<uint64_t>{field.from_montgomery(*field.from_rational(Ratio(-5, 21)))});
+    });
+    ASSERT_EQ (result, std::vector<Ratio>({Ratio(-5, 21)}));
+    ASSERT_EQ (calls.load(), 2);
+}
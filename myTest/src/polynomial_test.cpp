@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "Polynomial.h"
+
+using R = Rational<long long>;
+using P = RationalPolynomial<long long>;
+
+// random polynomial with small integer coefficients over small denominators
+P random_polynomial(std::mt19937& generator, size_t size) {
+    std::uniform_int_distribution<long long> numerator(-9, 9);
+    std::uniform_int_distribution<long long> denominator(1, 3);
+    std::vector<R> coefficients;
+    for (size_t i = 0; i < size; ++i) {
+        coefficients.push_back(R(numerator(generator), denominator(generator)));
+    }
+    return P(coefficients);
+}
+
+TEST (Polynomial, construction) {
+    ASSERT_EQ (P().degree(), -1);
+    ASSERT_TRUE (P({R(0), R(0)}).is_zero());
+    P p({R(1), R(0), R(2)});
+    ASSERT_EQ (p.degree(), 2);
+    ASSERT_EQ (p[2], R(2));
+    ASSERT_EQ (p[5], R(0));
+    ASSERT_EQ (P::monomial(R(3), 4).degree(), 4);
+    ASSERT_EQ (P::from_roots({R(1), R(-2)}), P({R(-2), R(1), R(1)}));
+    std::stringstream stream;
+    stream << P({R(1), R(-3), R(1, 2)});
+    ASSERT_EQ (stream.str(), "1/2 x^2 - 3/1 x + 1/1");
+}
+
+TEST (Polynomial, evaluation) {
+    P p({R(1), R(-3), R(1, 2)});
+    ASSERT_EQ (p(R(2)), R(-3));
+    ASSERT_EQ (p(R(1, 3)), R(1, 18));
+    std::vector<R> points = {R(0), R(2), R(1, 3), R(-7, 5), R(1000000, 3)};
+    std::vector<R> values = p.evaluate(points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_EQ (values[i], p(points[i]));
+    }
+    // the integer form overflows, the batch falls back to the Rational Horner scheme
+    P high = P::monomial(R(1), 9) + P({R(1, 7)});
+    ASSERT_EQ (high.evaluate(std::vector<R>{R(1000, 999)})[0], high(R(1000, 999)));
+    ASSERT_EQ (P().evaluate(points), std::vector<R>(points.size()));
+}
+
+TEST (Polynomial, arithmetic) {
+    P a({R(1), R(1)});
+    P b({R(-1), R(1)});
+    ASSERT_EQ (a * b, P({R(-1), R(0), R(1)}));
+    ASSERT_EQ (a + b, P({R(0), R(2)}));
+    ASSERT_EQ (a - a, P());
+    ASSERT_EQ (-a, P({R(-1), R(-1)}));
+    ASSERT_EQ (a * R(1, 2), P({R(1, 2), R(1, 2)}));
+    ASSERT_EQ (P({R(2), R(0), R(3)}).derivative(), P({R(0), R(6)}));
+}
+
+TEST (Polynomial, karatsuba) {
+    std::mt19937 generator(7);
+    for (size_t size : {1, 2, 5, 24, 31, 64}) {
+        P a = random_polynomial(generator, size);
+        P b = random_polynomial(generator, size / 2 + 1);
+        std::vector<R> expected = polynomial_detail::schoolbook(a.coefficients(), b.coefficients());
+        ASSERT_EQ (P(polynomial_detail::karatsuba(a.coefficients(), b.coefficients(), 2)), P(expected));
+        ASSERT_EQ (a * b, P(expected));
+    }
+}
+
+TEST (Polynomial, division) {
+    std::mt19937 generator(11);
+    for (int i = 0; i < 20; ++i) {
+        P a = random_polynomial(generator, 8);
+        P b = random_polynomial(generator, 4);
+        auto [quotient, remainder] = a.divide(b);
+        ASSERT_EQ (quotient * b + remainder, a);
+        ASSERT_LT (remainder.degree(), b.degree());
+    }
+    ASSERT_EQ (P({R(-1), R(0), R(1)}) / P({R(-1), R(1)}), P({R(1), R(1)}));
+    ASSERT_EQ (P({R(1), R(0), R(1)}) % P({R(0), R(1)}), P({R(1)}));
+    ASSERT_EQ (P({R(1)}).divide(P({R(0), R(1)})).first, P());
+    ASSERT_THROW (P({R(1)}).divide(P()), std::invalid_argument);
+}
+
+TEST (Polynomial, contentAndGcd) {
+    P p({R(1, 2), R(-3, 4), R(-3, 2)});
+    ASSERT_EQ (p.content(), R(-1, 4));
+    ASSERT_EQ (p.primitive_part(), P({R(-2), R(3), R(6)}));
+    ASSERT_EQ (p.content() * R(1) , R(-1, 4));
+    ASSERT_EQ (p.primitive_part() * p.content(), p);
+    ASSERT_EQ (p.monic().leading_coefficient(), R(1));
+
+    P common = P::from_roots({R(1, 2), R(-3)});
+    P a = common * P::from_roots({R(5)});
+    P b = common * P::from_roots({R(2, 3), R(7)}) * R(5, 3);
+    ASSERT_EQ (P::gcd(a, b), common.primitive_part());
+    ASSERT_EQ (P::gcd(a, P()), a.primitive_part());
+    ASSERT_EQ (P::gcd(P::from_roots({R(1)}), P::from_roots({R(2)})), P({R(1)}));
+    ASSERT_EQ (P::gcd(P(), P()), P());
+}
+
+TEST (Polynomial, interpolation) {
+    std::mt19937 generator(3);
+    P p = random_polynomial(generator, 6);
+    std::vector<R> xs = {R(0), R(1), R(-1), R(1, 2), R(3), R(-5, 3)};
+    std::vector<R> ys;
+    for (const R& x : xs) {
+        ys.push_back(p(x));
+    }
+    ASSERT_EQ (P::lagrange(xs, ys), p);
+    ASSERT_EQ (P::newton(xs, ys), p);
+    ASSERT_EQ (P::newton({R(2)}, {R(5)}), P({R(5)}));
+    ASSERT_EQ (P::lagrange({}, {}), P());
+    ASSERT_THROW (P::lagrange({R(1), R(1)}, {R(0), R(2)}), std::invalid_argument);
+    ASSERT_THROW (P::newton({R(1)}, {R(0), R(2)}), std::invalid_argument);
+}
+
+TEST (Polynomial, squareFreePart) {
+    P multiple = P::from_roots({R(1, 2), R(1, 2), R(-3), R(-3), R(-3), R(2)}) * R(4);
+    ASSERT_EQ (multiple.square_free_part(), P::from_roots({R(1, 2), R(-3), R(2)}).primitive_part());
+    P simple = P::from_roots({R(1), R(2), R(3), R(4), R(5), R(6), R(7), R(8), R(9), R(10)}) + P({R(1, 7)});
+    ASSERT_EQ (simple.square_free_part(), simple.primitive_part());
+}
+
+TEST (Polynomial, signVariations) {
+    ASSERT_EQ (P::from_roots({R(1), R(2), R(3)}).sign_variations(), 3);
+    ASSERT_EQ (P({R(1), R(0), R(1)}).sign_variations(), 0);
+    // x^2 - 2 : roots +-sqrt(2), Sturm sequence x^2 - 2, x, 1
+    std::vector<P> sturm = P({R(-2), R(0), R(1)}).sturm_sequence();
+    ASSERT_EQ (sturm.size(), 3u);
+    ASSERT_EQ (sturm[1], P({R(0), R(1)}));
+    ASSERT_EQ (P({R(-2), R(0), R(1)}).count_roots(R(0), R(2)), 1);
+    ASSERT_EQ (P({R(-2), R(0), R(1)}).count_roots(R(-2), R(2)), 2);
+    // multiple roots are counted once, a root at the upper bound is counted, not at the lower one
+    P multiple = P::from_roots({R(1), R(1), R(1), R(2)});
+    ASSERT_EQ (multiple.count_roots(R(0), R(3)), 2);
+    ASSERT_EQ (multiple.count_roots(R(0), R(1)), 1);
+    ASSERT_EQ (multiple.count_roots(R(1), R(3, 2)), 0);
+
+    // 4 real roots, the pseudo remainders need about 90 bits before their content is divided out
+    P quartic({R(-373, 54), R(25, 9), R(1577, 108), R(265, 36), R(1)});
+    ASSERT_EQ (quartic.count_roots(R(-1000), R(1000)), 4);
+    ASSERT_EQ (quartic.isolate_roots().size(), 4u);
+
+    // a Sturm sequence that doesn't fit in long long still counts the roots
+    P septic({R(99), R(-70), R(-53), R(-81), R(-21), R(-62), R(-22), R(-31)});
+    ASSERT_THROW (septic.sturm_sequence(), std::overflow_error);
+    ASSERT_EQ (septic.count_roots(R(-100), R(100)), 1);
+    ASSERT_EQ (septic.isolate_roots().size(), 1u);
+}
+
+TEST (Polynomial, rootIsolation) {
+    // x^2 - 2
+    std::vector<P::Interval> roots = P({R(-2), R(0), R(1)}).isolate_roots(R(1, 1000000));
+    ASSERT_EQ (roots.size(), 2u);
+    ASSERT_LE (roots[1].second - roots[1].first, R(1, 1000000));
+    ASSERT_LT (roots[1].first * roots[1].first, R(2));
+    ASSERT_GE (roots[1].second * roots[1].second, R(2));
+    ASSERT_EQ (roots[0].first, -roots[1].second);
+
+    // rational roots are found exactly, multiple roots once, intervals in increasing order
+    P exact = P::from_roots({R(-3), R(0), R(1, 2), R(1, 2), R(5)}) * R(7, 2);
+    roots = exact.isolate_roots(R(1, 1000));
+    ASSERT_EQ (roots.size(), 4u);
+    std::vector<R> expected = {R(-3), R(0), R(1, 2), R(5)};
+    for (size_t i = 0; i < roots.size(); ++i) {
+        ASSERT_LT (roots[i].first, expected[i] + R(1, 1000));
+        ASSERT_GE (roots[i].second, expected[i]);
+        ASSERT_LE (roots[i].second - roots[i].first, R(1, 1000));
+        ASSERT_EQ (exact.count_roots(roots[i].first, roots[i].second) , roots[i].first == roots[i].second ? 0 : 1);
+    }
+
+    // close roots 1/1000 apart
+    roots = P::from_roots({R(1, 3), R(1, 3) + R(1, 1000), R(-7, 4)}).isolate_roots();
+    ASSERT_EQ (roots.size(), 3u);
+    ASSERT_LE (roots[1].second, roots[2].first);
+
+    // Wilkinson-like product (x - 1)...(x - 10) with a shift of 1/7 : no root is rational any more
+    P wilkinson = P::from_roots({R(1), R(2), R(3), R(4), R(5), R(6), R(7), R(8), R(9), R(10)}) + P({R(1, 7)});
+    roots = wilkinson.isolate_roots(R(1, 1 << 20));
+    ASSERT_EQ (roots.size(), 10u);
+    ASSERT_EQ (wilkinson.count_roots(R(0), R(11)), 10);
+    for (size_t k = 0; k < roots.size(); ++k) {
+        // long double Newton from the root k + 1 of the product
+        long double r = k + 1;
+        for (int i = 0; i < 20; ++i) {
+            long double value = 0, slope = 0;
+            for (int j = wilkinson.degree(); j >= 0; --j) {
+                slope = slope * r + value;
+                value = value * r + (long double)wilkinson[j].get_numerator() / wilkinson[j].get_denominator();
+            }
+            r -= value / slope;
+        }
+        long double low = (long double)roots[k].first.get_numerator() / roots[k].first.get_denominator();
+        long double high = (long double)roots[k].second.get_numerator() / roots[k].second.get_denominator();
+        ASSERT_LT (low, r);
+        ASSERT_GT (high, r);
+        ASSERT_LE (roots[k].second - roots[k].first, R(1, 1 << 20));
+    }
+
+    ASSERT_TRUE (P({R(1), R(0), R(1)}).isolate_roots().empty());
+    ASSERT_TRUE (P({R(3)}).isolate_roots().empty());
+    ASSERT_THROW (P().isolate_roots(), std::invalid_argument);
+    ASSERT_THROW (P({R(0), R(1)}).isolate_roots(R(0)), std::invalid_argument);
+    // widths between 2^-32 and 2^-62, the endpoints are numerators over 2^62 at most
+    for (int k : {36, 50, 62}) {
+        roots = P({R(-2), R(0), R(1)}).isolate_roots(R(1, 1LL << k));
+        ASSERT_EQ (roots.size(), 2u);
+        // on __int128, the Rational difference of the endpoints overflows long long
+        __int128 low = roots[1].first.get_numerator(), low_denominator = roots[1].first.get_denominator();
+        __int128 high = roots[1].second.get_numerator(), high_denominator = roots[1].second.get_denominator();
+        ASSERT_TRUE ((high * low_denominator - low * high_denominator) << k == low_denominator * high_denominator);
+        ASSERT_TRUE (low * low < 2 * low_denominator * low_denominator);
+        ASSERT_TRUE (high * high > 2 * high_denominator * high_denominator);
+    }
+    // 2 sqrt(2) to 2^-62 needs numerators over 2^63
+    ASSERT_THROW (P({R(-8), R(0), R(1)}).isolate_roots(R(1, 1LL << 62)), std::overflow_error);
+}
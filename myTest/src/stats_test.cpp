@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Rational.h"
+
+TEST (RationalStats, enabled) {
+    ASSERT_TRUE (rational_stats::enabled);
+}
+
+TEST (RationalStats, bitLength) {
+    ASSERT_EQ (rational_stats::bit_length(0), 0);
+    ASSERT_EQ (rational_stats::bit_length(1), 1);
+    ASSERT_EQ (rational_stats::bit_length(-8), 4);
+    ASSERT_EQ (rational_stats::bit_length(std::numeric_limits<int>::min()), 32);
+    ASSERT_EQ (rational_stats::bit_length(std::numeric_limits<long long>::max()), 63);
+}
+
+TEST (RationalStats, constantEvaluation) {
+    // the counters don't prevent constant evaluation, and constant evaluations aren't counted
+    rational_stats::reset();
+    constexpr Rational<int> ratio(6, -4);
+    constexpr Rational<int> reversed = ratio.reverse();
+    static_assert(ratio.get_numerator() == -3 && reversed.get_denominator() == 3, "constexpr Rational");
+    ASSERT_EQ (rational_stats::snapshot().gcd_calls, 0u);
+}
+
+TEST (RationalStats, gcdAndValues) {
+    rational_stats::reset();
+    Rational<int> ratio(6, -4);
+    Rational<int> ratio2(5, 1);
+    rational_stats::Snapshot snapshot = rational_stats::snapshot();
+    ASSERT_EQ (snapshot.gcd_calls, 2u);
+    ASSERT_EQ (snapshot.numerator_bits[2], 1u);     // -3
+    ASSERT_EQ (snapshot.denominator_bits[2], 1u);   // 2
+    ASSERT_EQ (snapshot.numerator_bits[3], 1u);     // 5
+    ASSERT_EQ (snapshot.denominator_bits[1], 1u);   // 1
+    ASSERT_EQ (snapshot.near_overflows, 0u);
+}
+
+TEST (RationalStats, nearOverflow) {
+    rational_stats::reset();
+    Rational<int> ratio(std::numeric_limits<int>::max(), 2);
+    ASSERT_EQ (rational_stats::snapshot().near_overflows, 1u);
+    ASSERT_EQ (rational_stats::snapshot().numerator_bits[31], 1u);
+}
+
+TEST (RationalStats, reversal) {
+    rational_stats::reset();
+    Rational<int> ratio(4, -7);
+    ratio = ratio.reverse();
+    ratio = ratio.reverse();
+    ASSERT_EQ (rational_stats::snapshot().reversals, 2u);
+}
+
+TEST (RationalStats, conversionDepth) {
+    rational_stats::reset();
+    Rational<int> ratio = Rational<int>().convert_real_to_ratio<float>(8.0f, default_nb_iter);
+    rational_stats::Snapshot snapshot = rational_stats::snapshot();
+    ASSERT_EQ (snapshot.conversions, 1u);
+    ASSERT_EQ (snapshot.conversion_steps, 2u);  // 8 then the floating part 0
+    ASSERT_EQ (snapshot.conversion_depth[1], 1u);
+
+    rational_stats::reset();
+    ratio = ratio.convert_real_to_ratio<float>(0.36f, default_nb_iter);
+    snapshot = rational_stats::snapshot();
+    ASSERT_EQ (snapshot.conversions, 1u);
+    ASSERT_GT (snapshot.conversion_steps, 2u);
+    ASSERT_EQ (snapshot.conversion_depth[snapshot.conversion_steps - 1], 1u);
+    ASSERT_GT (snapshot.reversals, 0u);
+}
+
+TEST (RationalStats, threadsAggregation) {
+    rational_stats::reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([]() {
+            for (int i = 1; i <= 100; ++i)
+            {
+                Rational<int> ratio(i, 3);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    // the threads exited, their counters are kept
+    ASSERT_EQ (rational_stats::snapshot().gcd_calls, 400u);
+}
+
+TEST (RationalStats, dump) {
+    rational_stats::reset();
+    Rational<int> ratio(1, 2);
+    std::stringstream stream;
+    rational_stats::snapshot().dump(stream);
+    std::string line;
+    std::getline(stream, line);
+    ASSERT_EQ (line, "gcd_calls 1");
+    std::string text = stream.str();
+    ASSERT_NE (text.find("numerator_bits 1:1\n"), std::string::npos);
+    ASSERT_NE (text.find("denominator_bits 2:1\n"), std::string::npos);
+}
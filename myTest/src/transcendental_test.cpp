@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "Transcendental.h"
+
+using R = Rational<long long>;
+
+long double to_long_double(const R& ratio) {
+    return (long double)ratio.get_numerator() / (long double)ratio.get_denominator();
+}
+
+// the reference is long double : its own reduction of x is only good to about |x| 2^-63
+void expect_within(const R& result, long double expected, const R& epsilon, const R& x = R(0)) {
+    long double slack = 1e-17L + std::fabs(to_long_double(x)) * std::ldexp(1.0L, -63);
+    ASSERT_LE (std::fabs(to_long_double(result) - expected), to_long_double(epsilon) + slack) << result << " " << (double)expected;
+}
+
+const std::vector<R> arguments = {R(0), R(1, 2), R(1), R(-3), R(22, 7), R(355, 113), R(100), R(12345, 7), R(-987654, 13), R(1 << 20)};
+const std::vector<R> precisions = {R(1, 1000), R(1, 1000000), R(1, 1000000000), R(1, 1000000000000LL), R(1, 1000000000000000LL)};
+
+TEST (Transcendental, sinCos) {
+    for (const R& epsilon : precisions) {
+        Transcendental<long long> kernel(epsilon);
+        for (const R& x : arguments) {
+            expect_within(kernel.sin(x), std::sin(to_long_double(x)), epsilon, x);
+            expect_within(kernel.cos(x), std::cos(to_long_double(x)), epsilon, x);
+        }
+    }
+    ASSERT_EQ (rational_sin(R(0), R(1, 1000000)), R(0));
+    ASSERT_EQ (rational_cos(R(0), R(1, 1000000)), R(1));
+    // the smallest denominator within the bound
+    ASSERT_EQ (rational_sin(R(1, 2), R(1, 100)), R(8, 17));
+    ASSERT_EQ (rational_cos(R(355, 113), R(1, 1000)), R(-1));
+}
+
+TEST (Transcendental, tan) {
+    for (const R& epsilon : precisions) {
+        Transcendental<long long> kernel(epsilon);
+        for (const R& x : {R(0), R(1, 2), R(1), R(-3), R(100)}) {
+            expect_within(kernel.tan(x), std::tan(to_long_double(x)), epsilon, x);
+        }
+    }
+    ASSERT_EQ (rational_tan(R(0), R(1, 1000)), R(0));
+    // tan(3/2) ~ 14 : fine down to 1e-12, the 60 bits can't give 1e-15 near the pole
+    expect_within(rational_tan(R(3, 2), R(1, 1000000000000LL)), std::tan(1.5L), R(1, 1000000000000LL));
+    ASSERT_THROW (rational_tan(R(3, 2), R(1, 1000000000000000LL)), std::invalid_argument);
+}
+
+TEST (Transcendental, exp) {
+    for (const R& epsilon : precisions) {
+        Transcendental<long long> kernel(epsilon);
+        for (const R& x : {R(0), R(1, 2), R(1), R(-3), R(-50), R(-1000), R(7, 3)}) {
+            expect_within(kernel.exp(x), std::exp(to_long_double(x)), epsilon);
+        }
+    }
+    ASSERT_EQ (rational_exp(R(0), R(1, 1000)), R(1));
+    ASSERT_EQ (rational_exp(R(1), R(1, 1000)), R(87, 32));
+    // exp(10) ~ 22026 : the absolute bound is out of reach of the 60 bits below 1e-9
+    expect_within(rational_exp(R(10), R(1, 1000)), std::exp(10.0L), R(1, 1000));
+    expect_within(rational_exp(R(10), R(1, 1000000000)), std::exp(10.0L), R(1, 1000000000));
+    ASSERT_THROW (rational_exp(R(10), R(1, 1000000000000000LL)), std::invalid_argument);
+    ASSERT_THROW (rational_exp(R(50), R(1, 1000)), std::overflow_error);
+}
+
+TEST (Transcendental, pi) {
+    ASSERT_EQ (Transcendental<long long>(R(1, 100)).pi(), R(22, 7));
+    ASSERT_EQ (Transcendental<long long>(R(1, 1000000)).pi(), R(355, 113));
+    expect_within(Transcendental<long long>(R(1, 1000000000000000LL)).pi(), 3.14159265358979323846264338327950288L, R(1, 1000000000000000LL));
+}
+
+TEST (Transcendental, precisionControl) {
+    Transcendental<long long> coarse(R(1, 1000));
+    Transcendental<long long> fine(R(1, 1000000000000LL));
+    ASSERT_LT (coarse.degree(), fine.degree());
+    ASSERT_LT (coarse.sin(R(1)).get_denominator(), fine.sin(R(1)).get_denominator());
+}
+
+TEST (Transcendental, batch) {
+    Transcendental<long long> kernel(R(1, 1000000));
+    std::vector<R> sines = kernel.sin(arguments);
+    std::vector<R> cosines = kernel.cos(arguments);
+    std::vector<R> exponentials = kernel.exp(std::vector<R>({R(1), R(-2), R(1, 3)}));
+    ASSERT_EQ (sines.size(), arguments.size());
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        ASSERT_EQ (sines[i], kernel.sin(arguments[i]));
+        ASSERT_EQ (cosines[i], kernel.cos(arguments[i]));
+    }
+    ASSERT_EQ (exponentials[2], kernel.exp(R(1, 3)));
+}
+
+TEST (Transcendental, invalidArguments) {
+    ASSERT_THROW (Transcendental<long long>(R(0)), std::invalid_argument);
+    ASSERT_THROW (Transcendental<long long>(R(2)), std::invalid_argument);
+    ASSERT_THROW (Transcendental<long long>(R(1, 1000000000000000000LL)), std::invalid_argument);
+    ASSERT_THROW (rational_sin(R(1 << 25), R(1, 1000)), std::invalid_argument);
+    ASSERT_THROW (rational_exp(R(-(1 << 25)), R(1, 1000)), std::invalid_argument);
+    // just over 2^24 with a denominator over 2^39, den * 2^24 doesn't fit in long long
+    ASSERT_THROW (rational_sin(R((1LL << 62) + 1, 1LL << 38), R(1, 1000)), std::invalid_argument);
+}
+
+TEST (Transcendental, largeDenominators) {
+    // the bound |x| <= 2^24 must not overflow for small arguments : denominators over 2^7 for int, 2^39 for long long
+    using I = Rational<int>;
+    for (int d : {128, 129, 1000, 1 << 20}) {
+        I sine = rational_sin(I(1, d), I(1, 1000));
+        ASSERT_NEAR ((double)sine.get_numerator() / sine.get_denominator(), std::sin(1.0 / d), 1e-3);
+        I exponential = rational_exp(I(-3, d), I(1, 1000));
+        ASSERT_NEAR ((double)exponential.get_numerator() / exponential.get_denominator(), std::exp(-3.0 / d), 1e-3);
+    }
+    for (long long d : {1LL << 40, (1LL << 45) + 1, 1LL << 62}) {
+        expect_within(rational_exp(R(1, d), R(1, 1000000)), std::exp(1.0L / d), R(1, 1000000));
+        expect_within(rational_sin(R(-5, d), R(1, 1000000)), std::sin(-5.0L / d), R(1, 1000000));
+    }
+}